@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-lfid-split-weights.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/model/ndn-split-weight-table.hpp"
+
+#include "ndn-lfid-split-weights/weighted-random-strategy.hpp"
+
+using namespace ns3;
+
+/**
+ * This scenario computes loop-free inport-dependent (LFID) routes with split weights on the
+ * Abilene topology and forwards Interests with a strategy that follows the weights.
+ *
+ * Every LFID next hop gets a weight that prefers short detours over long ones and next hops
+ * with many loop-free continuations over next hops with few.  The weights are stored in the
+ * ns3::ndn::SplitWeightTable of each node, where nfd::fw::WeightedRandomStrategy reads them.
+ *
+ * To run scenario and see the weights and the forwarding decisions, use the following command:
+ *
+ *     NS_LOG=ndn.Consumer:ndn.Producer:WeightedRandomStrategy ./waf --run=ndn-lfid-split-weights
+ */
+
+using ns3::ndn::StackHelper;
+using ns3::ndn::AppHelper;
+using ns3::ndn::GlobalRoutingHelper;
+using ns3::ndn::StrategyChoiceHelper;
+using ns3::ndn::SplitWeightTable;
+using ns3::AnnotatedTopologyReader;
+
+int
+main(int argc, char* argv[])
+{
+  double exponent = 1;
+
+  CommandLine cmd;
+  cmd.AddValue("exponent", "Exponent of the cost ratio in the split weights", exponent);
+  cmd.Parse(argc, argv);
+
+  AnnotatedTopologyReader topologyReader;
+  topologyReader.SetFileName("src/ndnSIM/examples/topologies/topo-abilene.txt");
+  topologyReader.Read();
+
+  // LFID routes are calculated on the complete topology, without default routes
+  StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(false);
+  ndnHelper.InstallAll();
+
+  // Has to be run after StackHelper
+  topologyReader.ApplyOspfMetric();
+
+  const std::string prefix = "/prefix";
+  NodeContainer nodes = topologyReader.GetNodes();
+  Ptr<Node> consumer = nodes.Get(0);
+  Ptr<Node> producer = nodes.Get(10);
+
+  GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigin(prefix, producer);
+
+  // Calculate and install FIBs together with the split weights
+  GlobalRoutingHelper::SetLfidSplitWeights(true, exponent);
+  GlobalRoutingHelper::CalculateLFIDRoutes();
+
+  StrategyChoiceHelper::InstallAll<nfd::fw::WeightedRandomStrategy>("/");
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    auto weights = SplitWeightTable::Get(*node)->find(prefix);
+    if (weights == nullptr)
+      continue;
+
+    std::cout << "Node " << (*node)->GetId() << ":";
+    for (const auto& weight : *weights) {
+      std::cout << " face " << weight.face << " (" << weight.weight << ")";
+    }
+    std::cout << "\n";
+  }
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix(prefix);
+  consumerHelper.SetAttribute("Frequency", StringValue("100")); // 100 interests a second
+  consumerHelper.Install(consumer);
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix(prefix);
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(producer);
+
+  Simulator::Stop(Seconds(10.0));
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  return 0;
+}
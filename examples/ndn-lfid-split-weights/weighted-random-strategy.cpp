@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "weighted-random-strategy.hpp"
+
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/ndnSIM/model/ndn-split-weight-table.hpp"
+
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include "core/logger.hpp"
+
+NFD_LOG_INIT("WeightedRandomStrategy");
+
+namespace nfd {
+namespace fw {
+
+WeightedRandomStrategy::WeightedRandomStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder)
+{
+  this->setInstanceName(makeInstanceName(name, getStrategyName()));
+}
+
+WeightedRandomStrategy::~WeightedRandomStrategy()
+{
+}
+
+static bool
+canForwardToNextHop(const Face& inFace, const shared_ptr<pit::Entry>& pitEntry,
+                    const fib::NextHop& nexthop)
+{
+  return nexthop.getFace().getId() != inFace.getId()
+    && !wouldViolateScope(inFace, pitEntry->getInterest(), nexthop.getFace())
+    && canForwardToLegacy(*pitEntry, nexthop.getFace());
+}
+
+void
+WeightedRandomStrategy::afterReceiveInterest(const Face& inFace, const Interest& interest,
+                                             const shared_ptr<pit::Entry>& pitEntry)
+{
+  if (hasPendingOutRecords(*pitEntry)) {
+    // not a new Interest, don't forward
+    return;
+  }
+
+  const fib::Entry& fibEntry = this->lookupFib(*pitEntry);
+
+  // Strategies run in the context of their node
+  auto table = ns3::NodeList::GetNode(ns3::Simulator::GetContext())
+                 ->GetObject<ns3::ndn::SplitWeightTable>();
+  auto weights = table == nullptr ? nullptr : table->find(fibEntry.getPrefix());
+
+  std::vector<std::pair<Face*, double>> candidates;
+  double sum = 0;
+  for (const auto& nexthop : fibEntry.getNextHops()) {
+    if (!canForwardToNextHop(inFace, pitEntry, nexthop))
+      continue;
+
+    double weight = 1;
+    if (weights != nullptr) {
+      weight = 0;
+      for (const auto& entry : *weights) {
+        if (entry.face == nexthop.getFace().getId()) {
+          weight = entry.weight;
+        }
+      }
+    }
+    candidates.emplace_back(&nexthop.getFace(), weight);
+    sum += weight;
+  }
+
+  if (candidates.empty()) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
+    this->rejectPendingInterest(pitEntry);
+    return;
+  }
+
+  // Without weights for the remaining candidates, choose uniformly
+  if (sum <= 0) {
+    for (auto& candidate : candidates) {
+      candidate.second = 1;
+    }
+    sum = candidates.size();
+  }
+
+  boost::random::uniform_real_distribution<> dist(0, sum);
+  double point = dist(m_randomGenerator);
+  auto selected = candidates.begin();
+  for (; selected + 1 != candidates.end(); ++selected) {
+    point -= selected->second;
+    if (point < 0)
+      break;
+  }
+
+  NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " to=" << selected->first->getId());
+  this->sendInterest(pitEntry, *selected->first, interest);
+}
+
+const Name&
+WeightedRandomStrategy::getStrategyName()
+{
+  static Name strategyName("ndn:/localhost/nfd/strategy/weighted-random/%FD%01");
+  return strategyName;
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,56 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_EXAMPLES_NDN_LFID_SPLIT_WEIGHTS_WEIGHTED_RANDOM_STRATEGY_HPP
+#define NDNSIM_EXAMPLES_NDN_LFID_SPLIT_WEIGHTS_WEIGHTED_RANDOM_STRATEGY_HPP
+
+#include <boost/random/mersenne_twister.hpp>
+#include "face/face.hpp"
+#include "fw/strategy.hpp"
+#include "fw/algorithm.hpp"
+
+namespace nfd {
+namespace fw {
+
+/**
+ * Forwards every new Interest to one next hop, chosen at random in proportion to the split
+ * weights in the node's ns3::ndn::SplitWeightTable (uniformly if the FIB entry has none).  As
+ * LFID requires, the in-face of the Interest is never chosen.
+ */
+class WeightedRandomStrategy : public Strategy {
+public:
+  WeightedRandomStrategy(Forwarder& forwarder, const Name& name = getStrategyName());
+
+  virtual ~WeightedRandomStrategy() override;
+
+  virtual void
+  afterReceiveInterest(const Face& inFace, const Interest& interest,
+                       const shared_ptr<pit::Entry>& pitEntry) override;
+
+  static const Name&
+  getStrategyName();
+
+protected:
+  boost::random::mt19937 m_randomGenerator;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NDNSIM_EXAMPLES_NDN_LFID_SPLIT_WEIGHTS_WEIGHTED_RANDOM_STRATEGY_HPP
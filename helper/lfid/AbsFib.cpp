@@ -21,6 +21,8 @@
 #include "AbsFib.hpp"
 
 #include <algorithm>
+#include <numeric>
+#include <unordered_set>
 
 #include "ns3/node.h"
 #include "ns3/names.h"
@@ -31,18 +33,40 @@
 namespace ns3 {
 namespace ndn {
 
-using std::set;
+DstIndex::DstIndex(int numNodes) :
+      m_dstIds(static_cast<size_t>(numNodes)),
+      m_slots(static_cast<size_t>(numNodes))
+{
+  std::iota(m_dstIds.begin(), m_dstIds.end(), 0);
+  std::iota(m_slots.begin(), m_slots.end(), 0);
+}
+
+DstIndex::DstIndex(int numNodes, std::vector<int> dstIds) :
+      m_dstIds(std::move(dstIds)),
+      m_slots(static_cast<size_t>(numNodes), -1)
+{
+  std::sort(m_dstIds.begin(), m_dstIds.end());
+  for (size_t slot = 0; slot < m_dstIds.size(); slot++) {
+    assert(m_dstIds[slot] >= 0 && m_dstIds[slot] < numNodes);
+    assert(m_slots[m_dstIds[slot]] == -1);
+    m_slots[m_dstIds[slot]] = static_cast<int>(slot);
+  }
+}
 
 AbsFib::AbsFib(const Ptr<GlobalRouter>& own, int nodes) :
+      AbsFib(own, std::make_shared<DstIndex>(nodes))
+{
+}
+
+AbsFib::AbsFib(const Ptr<GlobalRouter>& own, std::shared_ptr<const DstIndex> dsts) :
 //      nodeId {own->GetL3Protocol()->getForwarder()->getNodeId()},
 //      nodeName {own->GetL3Protocol()->getForwarder()->getNodeName()},
       nodeId {static_cast<int>(own->GetObject<ns3::Node>()->GetId())},
       nodeName {ns3::Names::FindName(own->GetObject<ns3::Node>())},
-      numNodes {nodes},
+      numNodes {dsts->getNumNodes()},
       nodeDegree {static_cast<int>(own->GetIncidencies().size())},
       ownRouter {own},
-      upwardCounter {0},
-      totalNhCounter {0}
+      m_dsts {std::move(dsts)}
 {
   checkInputs();
 
@@ -54,77 +78,112 @@ void AbsFib::checkInputs() {
     std::cerr << nodeName << " has a degree of " << nodeDegree << "!\n\n";
   }
 
-  const auto MAX_SIZE {1e5};
-  assert(nodeId >= 0 && nodeId <= MAX_SIZE);
-  assert(nodeName.size() > 0 && nodeName.size() <= MAX_SIZE);
-  assert(nodeDegree >= 0 && nodeDegree <= MAX_SIZE);
-  assert(numNodes > 1 && numNodes <= MAX_SIZE);
+  assert(nodeId >= 0 && nodeId < numNodes);
+  assert(nodeName.size() > 0);
+  assert(nodeDegree >= 0);
+  assert(numNodes > 1);
 }
 
 void AbsFib::createEmptyFib() {
-  // Create empty FIB:
-  for (int dstId = 0; dstId < numNodes; dstId++) {
-    if (dstId == nodeId) {
-      continue;
-    }
-    perDstFib.insert( {dstId, {}});
-    upwardPerDstFib.insert( {dstId, {}});
-  }
+  // Create empty FIB: Storage for each dst is assigned on first insert.
+  const size_t numDsts {m_dsts->getDstIds().size()};
+  m_begin.assign(numDsts, 0);
+  m_end.assign(numDsts, 0);
+  m_upward.assign(numDsts, 0);
+  m_tailSlot = -1;
 }
 
 Ptr<GlobalRouter> AbsFib::getGR() const {
   return ownRouter;
 }
 
+uint32_t AbsFib::capacityEnd(int slot) const {
+  assert(slot <= m_tailSlot);
+  if (slot == m_tailSlot) {
+    return static_cast<uint32_t>(m_nexthops.size());
+  }
+  return m_begin[slot + 1];
+}
+
 // Setters:
 void AbsFib::insert(int dstId, const FibNextHop &nh) {
   assert(nh.getType() == NextHopType::DW || nh.getType() == NextHopType::UPWARD);
   assert(nh.getCost() > 0 && nh.getCostDelta() >= 0);
   assert(nh.getNhId() != nodeId);
+  assert(contains(dstId));
+  const int slot {m_dsts->getSlot(dstId)};
+
+  // Assign (empty) storage to all slots up to this one. Filling dsts in ascending order thus
+  // only ever appends to the array.
+  for (int i = m_tailSlot + 1; i <= slot; i++) {
+    m_begin[i] = m_end[i] = static_cast<uint32_t>(m_nexthops.size());
+    m_tailSlot = i;
+  }
 
-  bool inserted1 = perDstFib.at(dstId).insert(nh).second;
-  assert(inserted1); // Check if it didn't exist yet.
-  totalNhCounter++;
+  // Make room for one more nexthop:
+  if (m_end[slot] == capacityEnd(slot)) {
+    if (slot == m_tailSlot) {
+      m_nexthops.push_back(nh);
+    }
+    else {
+      m_nexthops.insert(m_nexthops.begin() + m_end[slot], nh);
+      for (int i = slot + 1; i <= m_tailSlot; i++) {
+        m_begin[i]++;
+        m_end[i]++;
+      }
+    }
+  }
+
+  // Keep the range sorted:
+  auto first = m_nexthops.begin() + m_begin[slot];
+  auto last = m_nexthops.begin() + m_end[slot];
+  assert(std::none_of(first, last, [&] (const FibNextHop& item) {
+    return item.getNhId() == nh.getNhId();
+  })); // Check if it didn't exist yet.
+
+  auto pos = std::upper_bound(first, last, nh);
+  std::move_backward(pos, last, last + 1);
+  *pos = nh;
+  m_end[slot]++;
 
   if (nh.getType() == NextHopType::UPWARD) {
-    bool inserted2 = upwardPerDstFib.at(dstId).insert(nh).second;
-    assert(inserted2);
-    upwardCounter++;
+    m_upward[slot]++;
   }
 }
 
 size_t AbsFib::erase(int dstId, int nhId) {
-  auto &fib {perDstFib.at(dstId)};
+  assert(contains(dstId));
+  const int slot {m_dsts->getSlot(dstId)};
+  auto first = m_nexthops.begin() + m_begin[slot];
+  auto last = m_nexthops.begin() + m_end[slot];
 
-  auto fibNh = std::find_if(fib.begin(), fib.end(), [&](const FibNextHop& item)
+  auto fibNh = std::find_if(first, last, [&](const FibNextHop& item)
   {
     return item.getNhId() == nhId;
   });
 
   // Element doesn't exist:
-  if(fibNh == fib.end()) {
-
-    // TODO: Figure out why this happens.
+  if(fibNh == last) {
     return 0;
   }
 
-  assert(fibNh != perDstFib.at(dstId).end());
   assert(fibNh->getType() == NextHopType::UPWARD);
-  totalNhCounter--;
 
-  fib.erase(fibNh);
-  auto numErased2 = upwardPerDstFib.at(dstId).erase(*fibNh);
-  assert(numErased2 == 1);
-  upwardCounter--;
+  std::move(fibNh + 1, last, fibNh);
+  m_end[slot]--;
+  m_upward[slot]--;
 
-  return numErased2;
+  return 1;
 }
 
 std::ostream& operator<<(std::ostream &os, const AbsFib &fib) {
-    for (const auto& entry : fib.perDstFib) {
+    for (int dstId : fib.getDstIds()) {
+      if (!fib.contains(dstId)) {
+        continue;
+      }
     	os << "\nFIB node: " << fib.nodeName << fib.nodeId << "\n";
-    	os << "Dst: " << entry.first << "\n";
-    	for (const auto &nh : entry.second) {
+    	os << "Dst: " << dstId << "\n";
+    	for (const auto &nh : fib.getNhs(dstId)) {
 				os << nh <<"\n";
     	}
     }
@@ -132,65 +191,50 @@ std::ostream& operator<<(std::ostream &os, const AbsFib &fib) {
 }
 
 // O(1)
-FibNextHop AbsFib::getNhAtPos(int dstId, int pos) const {
+const FibNextHop& AbsFib::getNhAtPos(int dstId, int pos) const {
   assert(dstId != nodeId);
+  assert(pos >= 0 && pos < numEnabledNhPerDst(dstId));
 
-  const auto &nhSet = getNhs(dstId);
-  auto nh = std::next(nhSet.begin(), pos);
-  if (pos == 0) {
-    assert(nh == nhSet.begin());
-  }
-
-  assert(nh != nhSet.end());
-  return *nh;
+  return m_nexthops[m_begin[m_dsts->getSlot(dstId)] + pos];
 }
 
 // O(1)
-set<FibNextHop> AbsFib::getNhs(int dstId) const {
+AbsFib::NhRange AbsFib::getNhs(int dstId) const {
   assert(dstId != nodeId);
-  if (perDstFib.count(dstId) == 0) {
+  if (!contains(dstId)) {
     std::cerr << "Node " << nodeId << " No nexthops for dst: " << dstId << "\n";
     return {};
   }
-  assert(perDstFib.count(dstId) != 0);
-  return perDstFib.at(dstId);
+  const int slot {m_dsts->getSlot(dstId)};
+  const FibNextHop* data = m_nexthops.data();
+  return {data + m_begin[slot], data + m_end[slot]};
 }
 
-set<FibNextHop> AbsFib::getUpwardNhs(int dstId) const {
-  assert(dstId != nodeId);
-  if (upwardPerDstFib.count(dstId) == 0) {
-    std::cerr << "Node " << nodeId << " No nexthops for dst: " << dstId << "\n";
-    return {};
-  }
-  return upwardPerDstFib.at(dstId);
+AbsFib::UpwardNhRange AbsFib::getUpwardNhs(int dstId) const {
+  const auto nhs = getNhs(dstId);
+  return {boost::make_filter_iterator<IsUpwardNh>(nhs.begin(), nhs.end()),
+          boost::make_filter_iterator<IsUpwardNh>(nhs.end(), nhs.end())};
 }
 
 
 int AbsFib::getTotalNexthops() const {
-//    int tmp {0};
-//    for (auto x : perDstFib) {
-//      tmp += x.second.size();
-//    }
-//    std::cout << "TotalNH: " << totalNhCounter << ", tmp: " << tmp << "\n";
-//    assert(totalNhCounter == tmp);
-  return totalNhCounter;
+  int total {0};
+  for (size_t slot = 0; slot < m_begin.size(); slot++) {
+    total += static_cast<int>(m_end[slot] - m_begin[slot]);
+  }
+  return total;
 }
 
 
 int AbsFib::countUwNexthops() const {
-//    int tmp {0};
-//    for (auto x : upwardPerDstFib){
-//      tmp+=x.second.size();
-//    }
-//    assert(upwardCounter == tmp);
-  return upwardCounter;
+  return static_cast<int>(std::accumulate(m_upward.begin(), m_upward.end(), 0u));
 }
 
 
 int AbsFib::numTypePerDst(int dstId, NextHopType type) const {
   assert(dstId != nodeId);
   const auto allNhs {numEnabledNhPerDst(dstId)};
-  const auto uwNhs {static_cast<int>(getUpwardNhs(dstId).size())};
+  const auto uwNhs {static_cast<int>(m_upward[m_dsts->getSlot(dstId)])};
 
   if (type == NextHopType::UPWARD) {
     return uwNhs;
@@ -207,16 +251,19 @@ int AbsFib::numTypePerDst(int dstId, NextHopType type) const {
 
 
 void AbsFib::checkFib() const {
-  assert(perDstFib.size() > 0);
+  assert(numNodes > 1);
 
-  for (const auto& fibSet : perDstFib) {
-    const size_t numNhs = fibSet.second.size();
-    assert(numNhs >= 0); // Was checking > 0.
+  for (int dstId : getDstIds()) {
+    if (!contains(dstId)) {
+      continue;
+    }
+    const auto nhs = getNhs(dstId);
+    const size_t numNhs = nhs.size();
 
     bool hasDownward{false};
     std::unordered_set<int> nextHopSet {};
 
-    for (const FibNextHop& nextHop : fibSet.second) {
+    for (const FibNextHop& nextHop : nhs) {
       assert(nextHop.getCost() > 0 && nextHop.getCost() < MAX_COST);
       if (nextHop.getType() == NextHopType::DW){
         hasDownward = true;
@@ -227,7 +274,8 @@ void AbsFib::checkFib() const {
       nextHopSet.emplace(nextHop.getNhId());
     }
     assert(hasDownward || numNhs == 0);
-    assert(nextHopSet.size() == fibSet.second.size());
+    assert(nextHopSet.size() == numNhs);
+    assert(std::is_sorted(nhs.begin(), nhs.end()));
   }
 }
 
@@ -20,10 +20,14 @@
 
 #pragma once
 
-#include <set>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 #include <ns3/ptr.h>
 
+#include <boost/iterator/filter_iterator.hpp>
+#include <boost/range/iterator_range.hpp>
+
 #include "FibNextHop.hpp"
 
 namespace ns3 {
@@ -38,10 +42,66 @@ class GlobalRouter;
 
 using AllNodeFib = std::unordered_map<int, AbsFib>;
 
+/*
+ * Destinations that the abstract FIBs keep entries for, and the storage slot of each. Shared by
+ * the AbsFibs of all nodes, so per-node storage scales with the number of dsts, not of nodes.
+ */
+class DstIndex
+{
+public:
+  // All nodes are dsts:
+  explicit DstIndex(int numNodes);
+
+  // Only the given dsts (no duplicates):
+  DstIndex(int numNodes, std::vector<int> dstIds);
+
+  int getNumNodes() const {
+    return static_cast<int>(m_slots.size());
+  }
+
+  // Ascending:
+  const std::vector<int>& getDstIds() const {
+    return m_dstIds;
+  }
+
+  // Slot of dstId, or -1 if it is not a dst:
+  int getSlot(int dstId) const {
+    return dstId >= 0 && dstId < getNumNodes() ? m_slots[dstId] : -1;
+  }
+
+private:
+  std::vector<int> m_dstIds;
+  std::vector<int> m_slots;
+};
+
+struct IsUpwardNh
+{
+  bool operator()(const FibNextHop& nh) const {
+    return nh.getType() == NextHopType::UPWARD;
+  }
+};
+
+/*
+ * Abstract FIB of a single node.
+ *
+ * All nexthops are stored in one contiguous array, with one range per destination that is
+ * sorted by (costDelta, cost, nhId). Ranges are handed out as non-owning views, which stay valid
+ * until the next insert().
+ *
+ * erase() only touches the range of the given dst, so different dsts can be erased concurrently.
+ */
 class AbsFib
 {
 public:
-    AbsFib(const Ptr<GlobalRouter>& own, int nodes);
+  // Non-owning view of the nexthops of one destination:
+  using NhRange = boost::iterator_range<const FibNextHop*>;
+  // Same, restricted to the upward nexthops:
+  using UpwardNhRange = boost::iterator_range<boost::filter_iterator<IsUpwardNh, const FibNextHop*>>;
+
+  // All nodes are dsts:
+  AbsFib(const Ptr<GlobalRouter>& own, int nodes);
+
+  AbsFib(const Ptr<GlobalRouter>& own, std::shared_ptr<const DstIndex> dsts);
 
 public:
 
@@ -49,20 +109,21 @@ public:
   /*
    * Returns FibNexthop at given position. Enter 0 or leave blank for SP NH.
    */
-  FibNextHop getNhAtPos(int dstId, int pos = 0) const;
+  const FibNextHop& getNhAtPos(int dstId, int pos = 0) const;
 
   /**
-   * Return reference to NH set per dst
+   * Return view of the NH range per dst
    */
-  std::set<FibNextHop> getNhs(int dstId) const;
+  NhRange getNhs(int dstId) const;
 
-  std::set<FibNextHop> getUpwardNhs(int dstId) const;
+  UpwardNhRange getUpwardNhs(int dstId) const;
 
   void checkFib() const;
 
   int numEnabledNhPerDst(int dstId) const {
-    assert(dstId != nodeId);
-    return static_cast<int>(getNhs(dstId).size());
+    assert(contains(dstId));
+    const int slot {m_dsts->getSlot(dstId)};
+    return static_cast<int>(m_end[slot] - m_begin[slot]);
   }
 
   int numTypePerDst(int dstId, NextHopType type) const;
@@ -81,8 +142,17 @@ public:
     return nodeDegree;
   }
 
-  int getNumDsts() const {
-    return static_cast<int>(perDstFib.size());
+  int getNumNodes() const {
+    return numNodes;
+  }
+
+  // All dsts, including the own node (see contains()):
+  const std::vector<int>& getDstIds() const {
+    return m_dsts->getDstIds();
+  }
+
+  const std::shared_ptr<const DstIndex>& getDstIndex() const {
+    return m_dsts;
   }
 
   int getTotalNexthops() const;
@@ -90,16 +160,7 @@ public:
   int countUwNexthops() const;
 
   bool contains(int dstId) const {
-    return perDstFib.count(dstId) > 0;
-  }
-
-  // Functions for range-based loop:
-  auto begin() const {
-    return perDstFib.cbegin();
-  }
-
-  auto end() const {
-    return perDstFib.cend();
+    return dstId != nodeId && m_dsts->getSlot(dstId) >= 0;
   }
 
 // Setters:
@@ -113,19 +174,25 @@ private:
 
   void createEmptyFib();
 
+  // Index past the storage reserved for the given slot.
+  uint32_t capacityEnd(int slot) const;
+
 private:
 	const int nodeId; // Own node id
 	const std::string nodeName; // Own node name
-	const int numNodes; // = numDsts.
+	const int numNodes;
 	const int nodeDegree;
 	const Ptr<GlobalRouter> ownRouter;
-
-	int upwardCounter;
-	int totalNhCounter;
-
-	// DstId -> set<FibNextHop>
-	unordered_map<int, std::set<FibNextHop>> perDstFib;
-	unordered_map<int, std::set<FibNextHop>> upwardPerDstFib;
+	const std::shared_ptr<const DstIndex> m_dsts;
+
+	// Nexthops of all dsts; the dst in slot i owns [m_begin[i], m_end[i]).
+	std::vector<FibNextHop> m_nexthops;
+	std::vector<uint32_t> m_begin;
+	std::vector<uint32_t> m_end;
+	// Number of upward nexthops per slot.
+	std::vector<uint32_t> m_upward;
+	// Highest slot that has storage assigned. Slots above it are empty, at the end of m_nexthops.
+	int m_tailSlot;
 
 	friend std::ostream& operator<<(std::ostream&,  const AbsFib &fib);
 };
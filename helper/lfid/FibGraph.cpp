@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2019 Klaus Schneider, The University of Arizona
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Klaus Schneider <klaus@cs.arizona.edu>
+ */
+
+#include "FibGraph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "AbsFib.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+constexpr uint32_t FibGraph::NO_ARC;
+
+void FibGraph::assign(const AllNodeFib &allNodeFIB, int dstId) {
+  int numNodes {0};
+  for (const auto& node : allNodeFIB) {
+    numNodes = std::max(numNodes, node.first + 1);
+  }
+
+  // 1. Count out-arcs per node:
+  m_outBegin.assign(static_cast<size_t>(numNodes) + 1, 0);
+  for (const auto& node : allNodeFIB) {
+    if (node.first != dstId) {
+      m_outBegin[node.first + 1] = node.second.numEnabledNhPerDst(dstId);
+    }
+  }
+  for (int i = 0; i < numNodes; i++) {
+    m_outBegin[i + 1] += m_outBegin[i];
+  }
+  const uint32_t numArcs {m_outBegin.back()};
+
+  // 2. Fill out-arcs:
+  m_outTarget.resize(numArcs);
+  m_arcSource.resize(numArcs);
+  m_arcEnabled.assign(numArcs, 1);
+  m_inBegin.assign(static_cast<size_t>(numNodes) + 1, 0);
+  for (const auto& node : allNodeFIB) {
+    int nodeId {node.first};
+    if (nodeId == dstId) {
+      continue;
+    }
+
+    uint32_t arc {m_outBegin[nodeId]};
+    for (const auto& fibNh : node.second.getNhs(dstId)) {
+      assert(fibNh.getNhId() >= 0 && fibNh.getNhId() < numNodes);
+      m_outTarget[arc] = fibNh.getNhId();
+      m_arcSource[arc] = nodeId;
+      m_inBegin[fibNh.getNhId() + 1]++;
+      arc++;
+    }
+    assert(arc == m_outBegin[nodeId + 1]);
+  }
+
+  // 3. In-arcs:
+  for (int i = 0; i < numNodes; i++) {
+    m_inBegin[i + 1] += m_inBegin[i];
+  }
+  m_inArc.resize(numArcs);
+  std::vector<uint32_t> pos(m_inBegin.begin(), m_inBegin.end() - 1);
+  for (uint32_t arc = 0; arc < numArcs; arc++) {
+    m_inArc[pos[m_outTarget[arc]]++] = arc;
+  }
+
+  if (m_fwdMark.size() != static_cast<size_t>(numNodes)) {
+    m_fwdMark.assign(numNodes, 0);
+    m_bwdMark.assign(numNodes, 0);
+    m_mark = 0;
+  }
+
+  computeComponents();
+}
+
+uint32_t FibGraph::findArc(int from, int to) const {
+  for (uint32_t arc = m_outBegin[from]; arc < m_outBegin[from + 1]; arc++) {
+    if (m_arcEnabled[arc] && m_outTarget[arc] == to) {
+      return arc;
+    }
+  }
+  return NO_ARC;
+}
+
+void FibGraph::removeArc(int from, int to) {
+  uint32_t arc {findArc(from, to)};
+  assert(arc != NO_ARC);
+  m_arcEnabled[arc] = 0;
+}
+
+/*
+ * Tarjan's algorithm, iterative to support deep graphs.
+ */
+void FibGraph::computeComponents() {
+  const int numNodes {getNumNodes()};
+  std::vector<int> index(numNodes, -1);
+  std::vector<int> low(numNodes, 0);
+  std::vector<uint8_t> onStack(numNodes, 0);
+  std::vector<int> stack;
+  // (Node, next out-arc to visit)
+  std::vector<std::pair<int, uint32_t>> dfs;
+
+  m_component.assign(numNodes, -1);
+  int nextIndex {0};
+  int numComponents {0};
+
+  auto visit = [&] (int v) {
+    index[v] = low[v] = nextIndex++;
+    stack.push_back(v);
+    onStack[v] = 1;
+    dfs.emplace_back(v, m_outBegin[v]);
+  };
+
+  for (int root = 0; root < numNodes; root++) {
+    if (index[root] >= 0) {
+      continue;
+    }
+
+    visit(root);
+    while (!dfs.empty()) {
+      int v {dfs.back().first};
+      uint32_t arc {dfs.back().second};
+
+      if (arc < m_outBegin[v + 1]) {
+        dfs.back().second++;
+        int w {m_outTarget[arc]};
+        if (index[w] < 0) {
+          visit(w);
+        }
+        else if (onStack[w]) {
+          low[v] = std::min(low[v], index[w]);
+        }
+        continue;
+      }
+
+      // All arcs of v done:
+      dfs.pop_back();
+      if (!dfs.empty()) {
+        int parent {dfs.back().first};
+        low[parent] = std::min(low[parent], low[v]);
+      }
+
+      if (low[v] == index[v]) {
+        int w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          onStack[w] = 0;
+          m_component[w] = numComponents;
+        } while (w != v);
+        numComponents++;
+      }
+    }
+  }
+}
+
+bool FibGraph::isReachable(int from, int to) {
+  assert(from != to);
+
+  // With arc (to -> from), any path (from -> to) closes a cycle, thus stays inside one component.
+  // Otherwise, the path could leave it, so search the whole graph.
+  int component {-1};
+  if (findArc(to, from) != NO_ARC) {
+    if (m_component[from] != m_component[to]) {
+      return false;
+    }
+    component = m_component[from];
+  }
+
+  if (++m_mark == 0) {
+    std::fill(m_fwdMark.begin(), m_fwdMark.end(), 0);
+    std::fill(m_bwdMark.begin(), m_bwdMark.end(), 0);
+    m_mark = 1;
+  }
+
+  m_fwdQueue.assign(1, from);
+  m_bwdQueue.assign(1, to);
+  m_fwdMark[from] = m_mark;
+  m_bwdMark[to] = m_mark;
+
+  // Always expand the smaller frontier:
+  while (!m_fwdQueue.empty() && !m_bwdQueue.empty()) {
+    bool met = m_fwdQueue.size() <= m_bwdQueue.size() ? expandForward(from, to, component)
+                                                      : expandBackward(from, to, component);
+    if (met) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool FibGraph::expandForward(int from, int to, int component) {
+  m_nextQueue.clear();
+  for (int u : m_fwdQueue) {
+    for (uint32_t arc = m_outBegin[u]; arc < m_outBegin[u + 1]; arc++) {
+      int v {m_outTarget[arc]};
+      if (!m_arcEnabled[arc] || (u == from && v == to)
+          || (component >= 0 && m_component[v] != component)) {
+        continue;
+      }
+      if (m_bwdMark[v] == m_mark) {
+        return true;
+      }
+      if (m_fwdMark[v] != m_mark) {
+        m_fwdMark[v] = m_mark;
+        m_nextQueue.push_back(v);
+      }
+    }
+  }
+  m_fwdQueue.swap(m_nextQueue);
+  return false;
+}
+
+bool FibGraph::expandBackward(int from, int to, int component) {
+  m_nextQueue.clear();
+  for (int v : m_bwdQueue) {
+    for (uint32_t i = m_inBegin[v]; i < m_inBegin[v + 1]; i++) {
+      uint32_t arc {m_inArc[i]};
+      int u {m_arcSource[arc]};
+      if (!m_arcEnabled[arc] || (u == from && v == to)
+          || (component >= 0 && m_component[u] != component)) {
+        continue;
+      }
+      if (m_fwdMark[u] == m_mark) {
+        return true;
+      }
+      if (m_bwdMark[u] != m_mark) {
+        m_bwdMark[u] = m_mark;
+        m_nextQueue.push_back(u);
+      }
+    }
+  }
+  m_bwdQueue.swap(m_nextQueue);
+  return false;
+}
+
+} // namespace ndn
+} // namespace ns3
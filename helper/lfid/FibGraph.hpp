@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2019 Klaus Schneider, The University of Arizona
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Klaus Schneider <klaus@cs.arizona.edu>
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class AbsFib;
+using AllNodeFib = std::unordered_map<int, AbsFib>;
+
+/*
+ * Directed graph of all FIB entries towards one destination, used for the loop check of
+ * removeLoops(). Arcs are stored in CSR form (out- and in-arcs) and can only be removed.
+ *
+ * Reachability queries for an uphill nexthop first compare the strongly connected components,
+ * computed once per destination: Removing arcs never merges components, so nodes in different
+ * components stay unreachable and the query is answered in O(1). Otherwise, an early-exit
+ * bidirectional BFS runs inside the component, with all scratch buffers reused across queries.
+ */
+class FibGraph
+{
+public:
+  /*
+   * Rebuild graph with one arc per nexthop of all nodes (except dstId) towards dstId.
+   */
+  void assign(const AllNodeFib &allNodeFIB, int dstId);
+
+  bool hasArc(int from, int to) const {
+    return findArc(from, to) != NO_ARC;
+  }
+
+  void removeArc(int from, int to);
+
+  /*
+   * Is node "to" reachable from node "from" without using the direct arc (from -> to)?
+   */
+  bool isReachable(int from, int to);
+
+  int getNumNodes() const {
+    return static_cast<int>(m_outBegin.size()) - 1;
+  }
+
+private:
+  static constexpr uint32_t NO_ARC = UINT32_MAX;
+
+  uint32_t findArc(int from, int to) const;
+
+  void computeComponents();
+
+  // Expand one BFS level, restricted to the given component (if >= 0).
+  // Returns true if the frontiers meet.
+  bool expandForward(int from, int to, int component);
+  bool expandBackward(int from, int to, int component);
+
+private:
+  // Out-arcs of node i: [m_outBegin[i], m_outBegin[i+1]).
+  std::vector<uint32_t> m_outBegin;
+  std::vector<int> m_outTarget;
+  std::vector<uint8_t> m_arcEnabled;
+  // In-arcs of node i: [m_inBegin[i], m_inBegin[i+1]), stored as index of the out-arc.
+  std::vector<uint32_t> m_inBegin;
+  std::vector<uint32_t> m_inArc;
+  std::vector<int> m_arcSource;
+
+  // Strongly connected component per node.
+  std::vector<int> m_component;
+
+  // Scratch buffers for the bidirectional BFS.
+  std::vector<uint32_t> m_fwdMark;
+  std::vector<uint32_t> m_bwdMark;
+  uint32_t m_mark {0};
+  std::vector<int> m_fwdQueue;
+  std::vector<int> m_bwdQueue;
+  std::vector<int> m_nextQueue;
+};
+
+} // namespace ndn
+} // namespace ns3
@@ -20,6 +20,9 @@
 
 #include "FibNextHop.hpp"
 
+#include <ostream>
+#include <tuple>
+
 #include "AbsFib.hpp"
 
 namespace ns3 {
@@ -28,13 +31,12 @@ namespace ndn {
 FibNextHop::FibNextHop(int cost, int nhId, int costDelta, NextHopType type) {
   assert(cost >= 0);
   assert(cost <= MAX_COST);
-  assert(nhId >= 0 && nhId <= NODE_ID_LIMIT);
+  assert(nhId >= 0);
 
   this->m_nhId = nhId;
   this->m_cost = cost;
   this->m_type = type;
   this->m_costDelta = costDelta;
-  this->path = {};
 }
 
 // Order of FibNexthop:
@@ -21,17 +21,15 @@
 #pragma once
 
 #include <cassert>
-#include <unordered_set>
+#include <cstdint>
+#include <iosfwd>
 
 namespace ns3 {
 namespace ndn {
 
-using ::std::unordered_set;
-
-constexpr int NODE_ID_LIMIT = 1000;
 constexpr long MAX_COST = 1 * 1000 * 1000;
 
-enum class NextHopType
+enum class NextHopType : uint8_t
 {
 	DW, UPWARD, DISABLED
 };
@@ -75,10 +73,6 @@ public:
 	  return m_type;
 	}
 
-	unordered_set<int> getPath() const {
-		return path;
-	}
-
 
 // Setters:
   void setType(const NextHopType& newType) {
@@ -97,9 +91,8 @@ public:
 private:
 	int m_cost;
 	int m_nhId;
-	NextHopType m_type;
 	int m_costDelta;
-	unordered_set<int> path;
+	NextHopType m_type;
 
 	friend ::std::ostream& operator<<(::std::ostream&, const FibNextHop &fib);
 };
@@ -19,17 +19,28 @@
  */
 
 #include "../ndn-global-routing-helper.hpp"
-#include "../boost-graph-ndn-global-routing-helper.hpp"
+#include "../ndn-global-routing-graph.hpp"
 //
-#include <boost/graph/graph_utility.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include "ns3/names.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
 //
 #include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-route-cache.hpp"
 #include "model/ndn-global-router.hpp"
+#include "model/ndn-split-weight-table.hpp"
+#include "utils/parallel-for.hpp"
 //
 #include "remove_loops.hpp"
 #include "AbsFib.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+
 
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelperLfid");
 
@@ -40,166 +51,911 @@ using std::unordered_map;
 using std::string;
 using std::get;
 
-void GlobalRoutingHelper::CalculateLFIDRoutes() {
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+using VertexId = GlobalRoutingGraph::VertexId;
 
-  // Creates graph from nodeList:
-  boost::NdnGlobalRouterGraph graph {};
+/*
+ * Fill the abstract FIB of one node. Only reads the (immutable) graph snapshot and distance
+ * table, thus can run concurrently for different nodes.
+ */
+static void
+fillAbsFib(const GlobalRoutingGraph& graph, const DistanceMatrix& distances, VertexId source,
+           AbsFib& nodeFib)
+{
+  const int nodeId = graph.getNodeId(source);
+  const auto INF = GlobalRoutingGraph::DISTANCE_INF;
+
+  // 1. Get all neighbors of node (one entry per neighbor node, the last edge wins):
+  // map: neighborId -> edge index
+  std::map<int, size_t> neighbors;
+  for (size_t e = graph.edgesBegin(source); e != graph.edgesEnd(source); e++) {
+    int nbId = graph.getNodeId(graph.getEdgeTarget(e));
+    assert(nbId != nodeId);
+    neighbors[nbId] = e;
+  }
 
-  AllNodeFib allNodeFIB;
+  // 2. Distances from the neighbors, excluding all paths through the source. Derived from the
+  // all-pairs table; only destinations behind the source need to be re-settled.
+  // map: neighborId -> Distance (by vertex)
+  std::map<int, std::vector<uint32_t>> neighborSpMap;
+  for (const auto& neighbor : neighbors) {
+    distances.computeDistancesAvoiding(graph.getEdgeTarget(neighbor.second), source,
+                                       neighborSpMap[neighbor.first]);
+  }
 
-  // Store mapping nodeId -> faceId -> Ptr<Face>
-  unordered_map<int, unordered_map<nfd::FaceId, shared_ptr<Face>>> faceMap;
+  // 3. Fill Abstract FIB:
+  // For each destination:
+  for (int dstId : nodeFib.getDstIds()) {
+    VertexId dst = graph.getVertex(static_cast<uint32_t>(dstId));
+    // Skip destination == source, and nodes without GlobalRouter.
+    if (dst == source || dst == GlobalRoutingGraph::INVALID_VERTEX) continue;
 
-  // For all existing nodes:
-  for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
+    int spTotalCost = static_cast<int>(distances.get(source, dst));
 
-    int nodeId = static_cast<int>((*node)->GetId());
-    const Ptr<GlobalRouter>& source = (*node)->GetObject<GlobalRouter>();
+    // For each neighbor:
+    for (const auto& nb : neighborSpMap) {
+      int neighborId = nb.first;
+      int neighborCost = static_cast<int>(nb.second[dst]);
+      int neighborTotalCost = neighborCost
+          + static_cast<int>(graph.getEdgeWeight(neighbors.at(neighborId)));
 
-    AbsFib nodeFib = AbsFib {source, static_cast<int>(NodeList::GetNNodes())};
+      assert(neighborTotalCost >= spTotalCost);
 
-    if (source == nullptr) {
-      NS_LOG_ERROR("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
+      // Skip routers that would loop back
+      if (neighborTotalCost >= static_cast<int>(INF))
+        continue;
+
+      NextHopType nbType;
+      if (neighborCost < spTotalCost) {
+        nbType = NextHopType::DW;
+      }
+      else {
+        nbType = NextHopType::UPWARD;
+      }
+
+      int costDelta = neighborTotalCost - spTotalCost;
+      FibNextHop nh = {neighborTotalCost, neighborId, costDelta, nbType};
+      nodeFib.insert(dstId, nh);
     }
+  } // End for all dsts
 
-    // map: neighborId -> DistancesMap
-    unordered_map<int, boost::DistancesMap> nbSp;
+  nodeFib.checkFib();
+}
 
-    // map: Destination (GlobalRouter) -> Distance
-    boost::DistancesMap distMap;
-    unordered_map<int, boost::DistancesMap> neighborSpMap;
+/*
+ * Create the (empty) abstract FIBs of all nodes with GlobalRouter. Accesses ns-3 objects, thus
+ * must run on the main thread.
+ */
+static AllNodeFib
+createAbsFibs(const GlobalRoutingGraph& graph, const std::shared_ptr<const DstIndex>& dsts)
+{
+  AllNodeFib allNodeFIB;
+  for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
+    int nodeId = static_cast<int>((*node)->GetId());
+    VertexId source = graph.getVertex(static_cast<uint32_t>(nodeId));
 
-    dijkstra_shortest_paths(graph, source,
-        distance_map(boost::ref(distMap)).distance_inf(boost::WeightInf).distance_zero(
-            boost::WeightZero).distance_compare(boost::WeightCompare()).distance_combine(
-            boost::WeightCombine()));
+    if (source == GlobalRoutingGraph::INVALID_VERTEX) {
+      NS_LOG_ERROR("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+      continue;
+    }
 
-    // 1. Get all neighbors of node.
-    unordered_map<nfd::FaceId, uint64_t> originalMetrics;
-    auto& originalFace = faceMap[nodeId];
+    allNodeFIB.emplace(nodeId, AbsFib {graph.getRouter(source), dsts});
+  }
+  return allNodeFIB;
+}
 
-    const GlobalRouter::IncidencyList &neighbors = source->GetIncidencies();
-    // Set link weight of all neighbors to infinity
-    for (const auto& neighbor : neighbors) {
-      int nbId = get<2>(neighbor)->GetObject<ns3::Node>()->GetId();
-      assert(nbId != nodeId);
+/*
+ * Create and fill the abstract FIBs of all nodes (before loop and dead end removal), using the
+ * all-pairs distance table.
+ */
+static AllNodeFib
+computeAbsFibs(const GlobalRoutingGraph& graph, const DistanceMatrix& distances,
+               const std::shared_ptr<const DstIndex>& dsts, uint32_t nThreads)
+{
+  AllNodeFib allNodeFIB = createAbsFibs(graph, dsts);
+
+  std::vector<std::pair<VertexId, AbsFib*>> work;
+  for (auto& nodeEntry : allNodeFIB) {
+    work.emplace_back(graph.getVertex(static_cast<uint32_t>(nodeEntry.first)), &nodeEntry.second);
+  }
 
-      auto& face = get<shared_ptr<Face>>(neighbor);
-      assert(face != nullptr);
+  // For all existing nodes (possibly in parallel):
+  ParallelFor(work.size(), nThreads, [&] (size_t i) {
+    fillAbsFib(graph, distances, work[i].first, *work[i].second);
+  });
 
-      originalMetrics[nbId] = face->getMetric();
-      originalFace[nbId] = face; // Is only a copy
-      face->setMetric(get<uint16_t>(boost::WeightInf));
+  return allNodeFIB;
+}
+
+/*
+ * Neighbors of each vertex: (neighborId, edge index), sorted by neighborId, one entry per
+ * neighbor node (the last edge wins, as in fillAbsFib).
+ */
+static std::vector<std::vector<std::pair<int, size_t>>>
+getNeighborEdges(const GlobalRoutingGraph& graph)
+{
+  std::vector<std::vector<std::pair<int, size_t>>> neighborEdges(graph.getNVertices());
+  for (VertexId v = 0; v < graph.getNVertices(); v++) {
+    std::map<int, size_t> neighbors;
+    for (size_t e = graph.edgesBegin(v); e != graph.edgesEnd(v); e++) {
+      neighbors[graph.getNodeId(graph.getEdgeTarget(e))] = e;
     }
+    neighborEdges[v].assign(neighbors.begin(), neighbors.end());
+  }
+  return neighborEdges;
+}
 
-    // 2. Calculate Dijkstra for neighbors
-    for (const auto& neighbor : neighbors) {
-      auto& nSource = get<0>(neighbor);
-      auto& target = get<2>(neighbor);
+/*
+ * Nexthop candidates of all nodes towards a single dst, without the all-pairs distance table
+ * (see DestinationTree). Scratch space is kept for the next dst.
+ */
+class DstCandidates
+{
+public:
+  DstCandidates(const GlobalRoutingGraph& graph,
+                const std::vector<std::vector<std::pair<int, size_t>>>& neighborEdges)
+    : m_graph(graph)
+    , m_neighborEdges(neighborEdges)
+    , m_tree(graph)
+  {
+  }
 
-      int nbId = target->GetObject<ns3::Node>()->GetId();
-      Ptr<GlobalRouter> nbRouter = target;
+  /*
+   * Compute the candidates towards dst (ordered by node).
+   */
+  void
+  run(VertexId dst, std::vector<std::pair<int, FibNextHop>>& candidates)
+  {
+    const auto INF = GlobalRoutingGraph::DISTANCE_INF;
+    candidates.clear();
+    m_tree.compute(dst);
+
+    for (VertexId source = 0; source < m_graph.getNVertices(); source++) {
+      const int nodeId = m_graph.getNodeId(source);
+      const int spTotalCost = static_cast<int>(m_tree.getDistance(source));
+      // Skip destination == source, channels, and nodes that cannot reach the dst.
+      if (source == dst || nodeId < 0 || spTotalCost >= static_cast<int>(INF)) continue;
+
+      for (const auto& neighbor : m_neighborEdges[source]) {
+        VertexId nb = m_graph.getEdgeTarget(neighbor.second);
+
+        int neighborCost = static_cast<int>(m_tree.getDistanceAvoiding(nb, source));
+        int neighborTotalCost = neighborCost
+          + static_cast<int>(m_graph.getEdgeWeight(neighbor.second));
 
-      assert(target != source && nbId != nodeId);
-      assert(nSource == source);
+        assert(neighborTotalCost >= spTotalCost);
+
+        // Skip routers that would loop back
+        if (neighborTotalCost >= static_cast<int>(INF))
+          continue;
 
-      dijkstra_shortest_paths(graph, nbRouter,
-          distance_map(boost::ref(neighborSpMap[nbId])).distance_inf(boost::WeightInf).distance_zero(
-              boost::WeightZero).distance_compare(boost::WeightCompare()).distance_combine(
-              boost::WeightCombine()));
+        NextHopType nbType = neighborCost < spTotalCost ? NextHopType::DW : NextHopType::UPWARD;
+        candidates.emplace_back(nodeId, FibNextHop {neighborTotalCost, neighbor.first,
+                                                    neighborTotalCost - spTotalCost, nbType});
+      }
     }
+  }
 
-    // 3. Reset link weights
-    for (const auto& neighbor : neighbors) {
-      int nbId = get<2>(neighbor)->GetObject<ns3::Node>()->GetId();
-      assert(nbId != nodeId);
+private:
+  const GlobalRoutingGraph& m_graph;
+  const std::vector<std::vector<std::pair<int, size_t>>>& m_neighborEdges;
+  DestinationTree m_tree;
+};
 
-      auto& face = get<shared_ptr<Face>>(neighbor);
-      assert(face->getMetric() == get<uint16_t>(boost::WeightInf));
-      face->setMetric(originalMetrics.at(nbId));
+/*
+ * Create and fill the abstract FIBs of all nodes (before loop and dead end removal), one dst at
+ * a time. Memory and work scale with the number of dsts instead of N^2. The time of the
+ * Dijkstra runs (with the candidates) and of filling the AbsFibs is added to the statistics.
+ */
+static AllNodeFib
+computeAbsFibsPerDst(const GlobalRoutingGraph& graph,
+                     const std::vector<std::vector<std::pair<int, size_t>>>& neighborEdges,
+                     const std::shared_ptr<const DstIndex>& dsts, uint32_t nThreads,
+                     RoutingStatistics& statistics)
+{
+  RoutingStatistics::Stopwatch phase;
+  AllNodeFib allNodeFIB = createAbsFibs(graph, dsts);
+  const auto& dstIds = dsts->getDstIds();
+
+  // For all dsts (possibly in parallel):
+  std::vector<std::vector<std::pair<int, FibNextHop>>> candidates(dstIds.size());
+  std::vector<DstCandidates> workers(GetNumWorkerThreads(nThreads), {graph, neighborEdges});
+  ParallelForWorkers(dstIds.size(), nThreads, [&] (uint32_t worker, size_t i) {
+    VertexId dst = graph.getVertex(static_cast<uint32_t>(dstIds[i]));
+    if (dst != GlobalRoutingGraph::INVALID_VERTEX) {
+      workers[worker].run(dst, candidates[i]);
     }
+  });
+  statistics.spfTime += phase.lap();
 
-    // 4. Fill Abstract FIB:
-    // For each destination:
-    for (const auto& dstEntry : distMap) {
-      Ptr<GlobalRouter> dstRouter = dstEntry.first;
-      int dstId = dstRouter->GetObject<ns3::Node>()->GetId();
-      if (dstRouter == source) continue; // Skip destination == source.
+  // Dsts in ascending order, which only appends to the AbsFibs:
+  for (size_t i = 0; i < dstIds.size(); i++) {
+    for (const auto& candidate : candidates[i]) {
+      allNodeFIB.at(candidate.first).insert(dstIds[i], candidate.second);
+    }
+    std::vector<std::pair<int, FibNextHop>>().swap(candidates[i]);
+  }
 
-      int spTotalCost = static_cast<int>(get<uint32_t>(dstEntry.second));
+  for (const auto& nodeEntry : allNodeFIB) {
+    nodeEntry.second.checkFib();
+  }
+  statistics.fibFillTime += phase.lap();
 
-      // For each neighbor:
-      for (const auto& nb : neighborSpMap) {
-        int neighborId = nb.first;
-        const auto& nbDist {get<uint32_t>(nb.second.at(dstRouter))};
+  return allNodeFIB;
+}
 
-        int neighborCost = static_cast<int>(nbDist);
-        int neighborTotalCost = neighborCost
-            + static_cast<int>(originalFace.at(neighborId)->getMetric());
+/*
+ * Dsts of the route calculation: All nodes that originate at least one prefix. Routes are only
+ * installed towards those, so no other dst needs an abstract FIB entry.
+ */
+static std::vector<int>
+getOriginIds(const GlobalRoutingGraph& graph)
+{
+  std::vector<int> dstIds;
+  for (VertexId v = 0; v < graph.getNVertices(); v++) {
+    if (graph.getNodeId(v) >= 0 && !graph.getRouter(v)->GetLocalPrefixes().empty()) {
+      dstIds.push_back(graph.getNodeId(v));
+    }
+  }
+  std::sort(dstIds.begin(), dstIds.end());
+  return dstIds;
+}
 
-        assert(neighborTotalCost >= spTotalCost);
+static std::shared_ptr<const DstIndex>
+getOriginDsts(const GlobalRoutingGraph& graph)
+{
+  return std::make_shared<DstIndex>(static_cast<int>(NodeList::GetNNodes()), getOriginIds(graph));
+}
 
-        // Skip routers that would loop back
-        if (neighborTotalCost >= static_cast<int>(get<uint16_t>(boost::WeightInf)))
-          continue;
+/*
+ * Split the (ascending) dsts into batches whose abstract FIBs fit into the memory budget in
+ * bytes (0: a single batch).
+ */
+static std::vector<std::vector<int>>
+getDstBatches(const GlobalRoutingGraph& graph, const std::vector<int>& dstIds, uint64_t budget)
+{
+  if (budget == 0 || dstIds.empty()) {
+    return {dstIds};
+  }
 
-        NextHopType nbType;
-        if (neighborCost < spTotalCost) {
-          nbType = NextHopType::DW;
-        }
-        else {
-          nbType = NextHopType::UPWARD;
-        }
+  // Upper bounds: every edge yields at most one candidate per dst, which is collected first and
+  // then inserted into an AbsFib. Each AbsFib has a range per dst in the batch.
+  const uint64_t nNodes = NodeList::GetNNodes();
+  const uint64_t nEdges = graph.getNVertices() == 0 ? 0 : graph.edgesEnd(graph.getNVertices() - 1);
+  const uint64_t perDst = nEdges * (sizeof(std::pair<int, FibNextHop>) + sizeof(FibNextHop))
+                          + nNodes * 3 * sizeof(uint32_t);
+  const uint64_t fixed = nNodes * (sizeof(AbsFib) + sizeof(AllNodeFib::value_type));
+
+  size_t batchSize = 1;
+  if (budget >= fixed + perDst) {
+    batchSize = static_cast<size_t>((budget - fixed) / perDst);
+  }
+  else {
+    NS_LOG_WARN("LFID memory budget of " << budget << " bytes is too small, using one dst per batch");
+  }
+
+  // Dsts that share a prefix (anycast) stay in one batch, as the FIB entry and split weights of
+  // the prefix depend on all of them. Such groups are joined with union-find:
+  std::vector<size_t> root(dstIds.size());
+  for (size_t i = 0; i < root.size(); i++) {
+    root[i] = i;
+  }
+  auto find = [&root] (size_t i) {
+    while (root[i] != i) {
+      i = root[i] = root[root[i]];
+    }
+    return i;
+  };
+  std::map<Name, size_t> firstOrigin;
+  for (size_t i = 0; i < dstIds.size(); i++) {
+    VertexId dst = graph.getVertex(static_cast<uint32_t>(dstIds[i]));
+    for (const Name& prefix : *graph.getPrefixes(dst)) {
+      size_t other = firstOrigin.emplace(prefix, i).first->second;
+      root[find(i)] = find(other);
+    }
+  }
 
-        int costDelta = neighborTotalCost - spTotalCost;
-        FibNextHop nh = {neighborTotalCost, neighborId, costDelta, nbType};
-        nodeFib.insert(dstId, nh);
+  // Groups in the order of their lowest dst, each batch filled with whole groups (a group
+  // larger than the batch size forms a batch of its own):
+  std::vector<std::vector<int>> groups;
+  std::vector<size_t> groupOf(dstIds.size(), dstIds.size());
+  for (size_t i = 0; i < dstIds.size(); i++) {
+    size_t r = find(i);
+    if (groupOf[r] == dstIds.size()) {
+      groupOf[r] = groups.size();
+      groups.emplace_back();
+    }
+    groups[groupOf[r]].push_back(dstIds[i]);
+  }
+
+  std::vector<std::vector<int>> batches;
+  for (const auto& group : groups) {
+    if (batches.empty() || batches.back().size() + group.size() > batchSize) {
+      batches.emplace_back();
+    }
+    batches.back().insert(batches.back().end(), group.begin(), group.end());
+  }
+  for (auto& batch : batches) {
+    std::sort(batch.begin(), batch.end());
+  }
+  return batches;
+}
+
+/*
+ * Prefixes of the (ascending) dsts, grouped by their origins. A prefix with several origins
+ * (anycast) has one FIB entry with the nexthops towards all of them, so prefixes with the same
+ * origins share their split weights.
+ */
+using PrefixOrigins = std::map<std::vector<int>, std::vector<Name>>;
+
+static PrefixOrigins
+getPrefixOrigins(const GlobalRoutingGraph& graph, const std::vector<int>& dstIds)
+{
+  std::map<Name, std::vector<int>> originsOf;
+  for (int dstId : dstIds) {
+    for (const Name& prefix : *graph.getPrefixes(graph.getVertex(static_cast<uint32_t>(dstId)))) {
+      auto& origins = originsOf[prefix];
+      if (origins.empty() || origins.back() != dstId) {
+        origins.push_back(dstId);
       }
+    }
+  }
 
-    } // End for all dsts
+  PrefixOrigins prefixOrigins;
+  for (auto& entry : originsOf) {
+    prefixOrigins[std::move(entry.second)].push_back(entry.first);
+  }
+  return prefixOrigins;
+}
+
+/*
+ * Face towards each neighbor of a node (the last edge wins, as in fillAbsFib).
+ * map: neighborId -> Ptr<Face>
+ */
+static unordered_map<int, shared_ptr<Face>>
+getNeighborFaces(const GlobalRoutingGraph& graph, int nodeId)
+{
+  unordered_map<int, shared_ptr<Face>> faces;
+  VertexId source = graph.getVertex(static_cast<uint32_t>(nodeId));
+  for (size_t e = graph.edgesBegin(source); e != graph.edgesEnd(source); e++) {
+    faces[graph.getNodeId(graph.getEdgeTarget(e))] = graph.getEdgeFace(e);
+  }
+  return faces;
+}
+
+/*
+ * Nexthops of the FIB entry of prefixes with the given origins on one node, by face. Each
+ * origin adds its nexthops in turn, so a face towards several origins keeps the cost of the
+ * last one, as with the route groups of installRoutes().
+ */
+static void
+getEntryNextHops(const AbsFib& fib, const std::vector<int>& originIds,
+                 const unordered_map<int, shared_ptr<Face>>& faces,
+                 std::map<nfd::FaceId, FibHelper::NextHop>& nextHops)
+{
+  nextHops.clear();
+  for (int dstId : originIds) {
+    if (!fib.contains(dstId)) {
+      continue;
+    }
+    for (const auto& nh : fib.getNhs(dstId)) {
+      const auto& face = faces.at(nh.getNhId());
+      nextHops[face->getId()] = {face, nh.getCost()};
+    }
+  }
+}
 
-    nodeFib.checkFib();
-    allNodeFIB.emplace(nodeId, nodeFib);
-  } // End for all nodes
+/*
+ * Split weights of the FIB entry towards the given origins on one node: d_i * (c_min / c_i)^exp
+ * for the nexthops towards every origin, with d_i the number of nexthops of the neighbor towards
+ * that origin and c_min the lowest cost of the entry (see SetLfidSplitWeights). A face towards
+ * several origins gets its largest weight, then the weights are normalized.
+ * Returns nullptr if the node has no nexthop towards any of the origins.
+ */
+static shared_ptr<const SplitWeightTable::WeightList>
+computeSplitWeights(const AllNodeFib& allNodeFIB, const AbsFib& fib,
+                    const std::vector<int>& originIds,
+                    const unordered_map<int, shared_ptr<Face>>& faces, double exponent)
+{
+  int minCost = std::numeric_limits<int>::max();
+  for (int dstId : originIds) {
+    if (fib.contains(dstId)) {
+      for (const auto& nh : fib.getNhs(dstId)) {
+        minCost = std::min(minCost, nh.getCost());
+      }
+    }
+  }
+  if (minCost == std::numeric_limits<int>::max()) {
+    return nullptr;
+  }
 
+  std::map<nfd::FaceId, double> weightOf;
+  std::vector<double> diversities;
+  for (int dstId : originIds) {
+    if (!fib.contains(dstId)) {
+      continue;
+    }
+    const auto nexthops = fib.getNhs(dstId);
+
+    // Path diversity: One path per remaining nexthop of the neighbor. The dst itself needs no
+    // further paths, so it counts as the most diverse neighbor.
+    diversities.clear();
+    double maxDiversity = 1;
+    for (const auto& nh : nexthops) {
+      const AbsFib& nbFib = allNodeFIB.at(nh.getNhId());
+      diversities.push_back(nbFib.contains(dstId) ? nbFib.getNhs(dstId).size() : 0);
+      maxDiversity = std::max(maxDiversity, diversities.back());
+    }
 
-  ///  4. Remove loops and Deadends ///
-  removeLoops(allNodeFIB, true);
-  removeDeadEnds(allNodeFIB, true);
-  std::cout << "\n";
+    for (size_t i = 0; i < diversities.size(); i++) {
+      const FibNextHop& nh = nexthops[i];
+      double diversity = nh.getNhId() == dstId ? maxDiversity : std::max(1.0, diversities[i]);
+      // Stretch is c_i / c_min = 1 + costDelta / c_min:
+      double stretch = static_cast<double>(nh.getCost()) / std::max(1, minCost);
+      double& weight = weightOf[faces.at(nh.getNhId())->getId()];
+      weight = std::max(weight, diversity * std::pow(stretch, -exponent));
+    }
+  }
 
-  // 5. Insert from AbsFIB into real FIB!
+  double sum = 0;
+  for (const auto& weight : weightOf) {
+    sum += weight.second;
+  }
+  auto weights = make_shared<SplitWeightTable::WeightList>();
+  for (const auto& weight : weightOf) {
+    weights->push_back({weight.first, weight.second / sum});
+  }
+  return weights;
+}
+
+/*
+ * Insert from AbsFIB into real FIB! One route group per dst, attached to the prefixes of the
+ * dst. Routes are also recorded in the cache and counted in the statistics. If an exponent is
+ * given, the split weights of each FIB entry (over all origins of its prefix) are also stored
+ * in the SplitWeightTable of each node.
+ */
+static void
+installRoutes(const GlobalRoutingGraph& graph, const AllNodeFib& allNodeFIB,
+              const PrefixOrigins& prefixOrigins, RoutingStatistics& statistics,
+              RouteCache* cache, const double* splitWeightExponent)
+{
   // For each node in the AbsFIB: Insert into real fib.
+  std::vector<FibHelper::RouteGroup> routes;
   for (const auto& nodeEntry : allNodeFIB) {
     int nodeId = nodeEntry.first;
     const auto& fib = nodeEntry.second;
+    const auto faces = getNeighborFaces(graph, nodeId);
+    routes.clear();
+
+    Ptr<Node> node = NodeList::GetNode(static_cast<uint32_t>(nodeId));
+    Ptr<SplitWeightTable> weights;
+    if (splitWeightExponent != nullptr) {
+      weights = SplitWeightTable::Get(node);
+    }
 
     // For each destination:
-    for (const auto& dst : fib) {
-      int dstId = dst.first;
-      const auto& dstRouter = allNodeFIB.at(dstId).getGR();
-
-      // Each fibNexthop
-      for (const auto& nh : dst.second) {
-        int neighborId = nh.getNhId();
-        int neighborTotalCost = nh.getCost();
-
-        for (const auto& prefix : dstRouter->GetLocalPrefixes()) {
-          Ptr<Node> node = NodeList::GetNode(static_cast<uint32_t>(nodeId));
-          FibHelper::AddRoute(node, *prefix, faceMap.at(nodeId).at(neighborId),
-              neighborTotalCost);
+    for (int dstId : fib.getDstIds()) {
+      if (!fib.contains(dstId)) {
+        continue;
+      }
+      const auto nexthops = fib.getNhs(dstId);
+      const auto& prefixes = graph.getPrefixes(graph.getVertex(static_cast<uint32_t>(dstId)));
+      if (nexthops.empty() || prefixes->empty()) {
+        continue;
+      }
+
+      routes.push_back({prefixes, {}});
+      for (const auto& nh : nexthops) {
+        routes.back().nextHops.push_back({faces.at(nh.getNhId()), nh.getCost()});
+        if (nh.getType() == NextHopType::UPWARD) {
+          statistics.nUpwardNextHops++;
         }
       }
     }
+    statistics.addRoutes(routes);
+
+    if (weights != nullptr) {
+      for (const auto& origins : prefixOrigins) {
+        auto list = computeSplitWeights(allNodeFIB, fib, origins.first, faces,
+                                        *splitWeightExponent);
+        if (list != nullptr) {
+          weights->set(origins.second, list);
+        }
+      }
+    }
+
+    if (cache != nullptr) {
+      cache->add(node, routes);
+    }
+    FibHelper::AddRoutes(node, routes);
   }
 }
 
+void GlobalRoutingHelper::CalculateLFIDRoutes() {
+  // A full calculation does not keep any state:
+  ResetLfidState();
+
+  RoutingStatistics statistics("lfid", GetNumWorkerThreads(m_nThreads));
+  RoutingStatistics::Stopwatch total;
+  RoutingStatistics::Stopwatch phase;
+
+  // The cache does not store split weights:
+  RouteCache cache(m_isLfidSplitWeights ? "" : m_routeCacheDirectory, "lfid");
+  if (cache.install()) {
+    statistics.isCached = true;
+    statistics.installTime = phase.lap();
+    PublishStatistics(statistics, total);
+    return;
+  }
+
+  // Immutable snapshot of the topology. The source node is excluded per Dijkstra run, instead
+  // of temporarily setting its face metrics to infinity:
+  const GlobalRoutingGraph graph {};
+  const auto neighborEdges = getNeighborEdges(graph);
+  statistics.setTopology(graph);
+
+  // Only prefix origins are dsts. Dsts are independent, so they are processed in batches that
+  // fit into the memory budget, and each batch is discarded once installed:
+  auto batches = getDstBatches(graph, getOriginIds(graph), m_lfidMemoryBudget);
+  const bool isSingleBatch = batches.size() == 1;
+  statistics.snapshotTime = phase.lap();
+
+  for (auto& batch : batches) {
+    auto dsts = std::make_shared<const DstIndex>(static_cast<int>(NodeList::GetNNodes()),
+                                                 std::move(batch));
+
+    // Each dst is handled by its own (reverse) Dijkstra:
+    AllNodeFib allNodeFIB = computeAbsFibsPerDst(graph, neighborEdges, dsts, m_nThreads,
+                                                 statistics);
+    phase.lap();
+
+    ///  4. Remove loops and Deadends ///
+    int nUpward = 0;
+    statistics.nRemovedLoops += removeLoops(allNodeFIB, m_isVerbose && isSingleBatch, m_nThreads,
+                                            &nUpward);
+    statistics.nUpwardCandidates += nUpward;
+    statistics.loopRemovalTime += phase.lap();
+
+    statistics.nRemovedDeadEnds += removeDeadEnds(allNodeFIB, m_isVerbose && isSingleBatch,
+                                                  m_nThreads);
+    statistics.deadEndRemovalTime += phase.lap();
+
+    // 5. Insert from AbsFIB into real FIB!
+    PrefixOrigins prefixOrigins;
+    if (m_isLfidSplitWeights) {
+      prefixOrigins = getPrefixOrigins(graph, dsts->getDstIds());
+    }
+    installRoutes(graph, allNodeFIB, prefixOrigins, statistics, &cache,
+                  m_isLfidSplitWeights ? &m_lfidSplitWeightExponent : nullptr);
+    statistics.installTime += phase.lap();
+  }
 
+  cache.save();
+  statistics.installTime += phase.lap();
+  PublishStatistics(statistics, total);
+}
 
-} // namespace ndn
-} // namespace ns3
+/*
+ * State of UpdateLFIDRoutes() between calls.
+ */
+struct LfidState {
+  std::unique_ptr<GlobalRoutingGraph> graph;
+  // Local prefixes per vertex:
+  std::vector<std::vector<Name>> origins;
+  std::shared_ptr<const DstIndex> dsts;
+  PrefixOrigins prefixOrigins;
+  std::unique_ptr<DistanceMatrix> distances;
+  // Abstract FIBs before loop and dead end removal:
+  AllNodeFib candidates;
+  // Abstract FIBs as installed:
+  AllNodeFib installed;
+};
+
+static std::unique_ptr<LfidState> g_lfidState;
+
+void GlobalRoutingHelper::ResetLfidState() {
+  g_lfidState.reset();
+}
+
+static std::vector<std::vector<Name>>
+getOrigins(const GlobalRoutingGraph& graph)
+{
+  std::vector<std::vector<Name>> origins(graph.getNVertices());
+  for (VertexId v = 0; v < graph.getNVertices(); v++) {
+    for (const auto& prefix : graph.getRouter(v)->GetLocalPrefixes()) {
+      origins[v].push_back(*prefix);
+    }
+  }
+  return origins;
+}
+
+static bool
+isSameNh(const FibNextHop& a, const FibNextHop& b)
+{
+  return a.getNhId() == b.getNhId() && a.getCost() == b.getCost()
+    && a.getCostDelta() == b.getCostDelta() && a.getType() == b.getType();
+}
+
+/*
+ * Remove the routes (and split weights) that the previous state installed, but the new abstract
+ * FIBs do not contain. The old routes are rebuilt from the old graph and origins, as withdrawn
+ * prefixes and vanished faces are no longer in the new graph.
+ */
+static void
+removeStaleRoutes(const LfidState& old, const GlobalRoutingGraph& graph,
+                  const AllNodeFib& installed, bool isSplitWeights)
+{
+  std::vector<FibHelper::Route> removed;
+  std::set<std::pair<Name, nfd::FaceId>> newRoutes;
+  std::set<Name> newPrefixes;
+  for (const auto& nodeEntry : old.installed) {
+    int nodeId = nodeEntry.first;
+    const AbsFib& oldFib = nodeEntry.second;
+    removed.clear();
+    newRoutes.clear();
+    newPrefixes.clear();
+
+    auto newFib = installed.find(nodeId);
+    if (newFib != installed.end()) {
+      const auto faces = getNeighborFaces(graph, nodeId);
+      for (int dstId : newFib->second.getDstIds()) {
+        if (!newFib->second.contains(dstId)) {
+          continue;
+        }
+        const auto& prefixes = graph.getPrefixes(graph.getVertex(static_cast<uint32_t>(dstId)));
+        for (const auto& nh : newFib->second.getNhs(dstId)) {
+          for (const Name& prefix : *prefixes) {
+            newRoutes.emplace(prefix, faces.at(nh.getNhId())->getId());
+            newPrefixes.insert(prefix);
+          }
+        }
+      }
+    }
+
+    const auto oldFaces = getNeighborFaces(*old.graph, nodeId);
+    Ptr<Node> node = NodeList::GetNode(static_cast<uint32_t>(nodeId));
+    for (int dstId : oldFib.getDstIds()) {
+      if (!oldFib.contains(dstId)) {
+        continue;
+      }
+      const auto nexthops = oldFib.getNhs(dstId);
+      const auto& prefixes = old.origins[old.graph->getVertex(static_cast<uint32_t>(dstId))];
+      for (const auto& nh : nexthops) {
+        const auto& face = oldFaces.at(nh.getNhId());
+        for (const Name& prefix : prefixes) {
+          if (newRoutes.count({prefix, face->getId()}) == 0) {
+            removed.push_back({prefix, face, nh.getCost()});
+          }
+        }
+      }
+
+      if (isSplitWeights && !nexthops.empty()) {
+        Ptr<SplitWeightTable> weights = SplitWeightTable::Get(node);
+        for (const Name& prefix : prefixes) {
+          if (newPrefixes.count(prefix) == 0) {
+            weights->erase(prefix);
+          }
+        }
+      }
+    }
+
+    FibHelper::RemoveRoutes(node, removed);
+  }
+}
+
+void GlobalRoutingHelper::UpdateLFIDRoutes() {
+  RoutingStatistics statistics("lfid-update", GetNumWorkerThreads(m_nThreads));
+  RoutingStatistics::Stopwatch total;
+  RoutingStatistics::Stopwatch phase;
+
+  auto graph = make_unique<GlobalRoutingGraph>();
+  auto origins = getOrigins(*graph);
+  statistics.setTopology(*graph);
+  statistics.snapshotTime = phase.lap();
+
+  // 1. First call, or the topology changed: Full calculation, keeping all state.
+  if (g_lfidState == nullptr || !graph->hasSameEdges(*g_lfidState->graph)
+      || origins != g_lfidState->origins) {
+    if (g_lfidState == nullptr) {
+      Simulator::ScheduleDestroy(&GlobalRoutingHelper::ResetLfidState);
+    }
+
+    auto state = make_unique<LfidState>();
+    state->dsts = getOriginDsts(*graph);
+    state->prefixOrigins = getPrefixOrigins(*graph, state->dsts->getDstIds());
+    state->distances = make_unique<DistanceMatrix>(*graph, m_nThreads);
+    statistics.spfTime = phase.lap();
+
+    state->candidates = computeAbsFibs(*graph, *state->distances, state->dsts, m_nThreads);
+    state->installed = AllNodeFib {state->candidates};
+    statistics.fibFillTime = phase.lap();
+
+    int nUpward = 0;
+    statistics.nRemovedLoops = removeLoops(state->installed, m_isVerbose, m_nThreads, &nUpward);
+    statistics.nUpwardCandidates = nUpward;
+    statistics.loopRemovalTime = phase.lap();
 
+    statistics.nRemovedDeadEnds = removeDeadEnds(state->installed, m_isVerbose, m_nThreads);
+    statistics.deadEndRemovalTime = phase.lap();
 
+    // The new routes replace all routes of the previous state:
+    if (g_lfidState != nullptr) {
+      removeStaleRoutes(*g_lfidState, *graph, state->installed, m_isLfidSplitWeights);
+    }
+    installRoutes(*graph, state->installed, state->prefixOrigins, statistics, nullptr,
+                  m_isLfidSplitWeights ? &m_lfidSplitWeightExponent : nullptr);
+    statistics.installTime = phase.lap();
+
+    state->graph = std::move(graph);
+    state->origins = std::move(origins);
+    g_lfidState = std::move(state);
+    PublishStatistics(statistics, total);
+    return;
+  }
+
+  LfidState& state = *g_lfidState;
+
+  // 2. Only recompute distances from sources whose shortest paths changed:
+  state.distances->update(*graph, m_nThreads);
+  state.graph = std::move(graph);
+  statistics.spfTime = phase.lap();
+
+  AllNodeFib candidates = computeAbsFibs(*state.graph, *state.distances, state.dsts,
+                                         m_nThreads);
+
+  // 3. Dsts with changed candidates of any node:
+  const auto& dstIds = state.dsts->getDstIds();
+  std::vector<int> changedDsts;
+  for (int dstId : dstIds) {
+    bool isChanged = false;
+    for (const auto& nodeEntry : candidates) {
+      const auto& fib = nodeEntry.second;
+      if (!fib.contains(dstId)) {
+        continue;
+      }
+      const auto newNhs = fib.getNhs(dstId);
+      const auto oldNhs = state.candidates.at(nodeEntry.first).getNhs(dstId);
+      if (!std::equal(newNhs.begin(), newNhs.end(), oldNhs.begin(), oldNhs.end(), &isSameNh)) {
+        isChanged = true;
+        break;
+      }
+    }
+    if (isChanged) {
+      changedDsts.push_back(dstId);
+    }
+  }
+
+  NS_LOG_DEBUG("Link update affects " << changedDsts.size() << " of " << dstIds.size() << " dsts");
+  if (changedDsts.empty()) {
+    state.candidates = std::move(candidates);
+    statistics.fibFillTime = phase.lap();
+    PublishStatistics(statistics, total);
+    return;
+  }
+
+  // 4. New abstract FIBs: Changed dsts from the new candidates, others as installed.
+  std::vector<bool> isChangedDst(NodeList::GetNNodes(), false);
+  for (int dstId : changedDsts) {
+    isChangedDst[dstId] = true;
+  }
+
+  AllNodeFib installed;
+  for (const auto& nodeEntry : candidates) {
+    int nodeId = nodeEntry.first;
+    const AbsFib& oldFib = state.installed.at(nodeId);
+    AbsFib fib {nodeEntry.second.getGR(), state.dsts};
+
+    for (int dstId : dstIds) {
+      if (!fib.contains(dstId)) {
+        continue;
+      }
+      for (const auto& nh : (isChangedDst[dstId] ? nodeEntry.second : oldFib).getNhs(dstId)) {
+        fib.insert(dstId, nh);
+      }
+    }
+    installed.emplace(nodeId, std::move(fib));
+  }
+
+  statistics.fibFillTime = phase.lap();
+
+  int nUpward = 0;
+  statistics.nRemovedLoops = removeLoops(installed, changedDsts, false, m_nThreads, &nUpward);
+  statistics.nUpwardCandidates = nUpward;
+  statistics.loopRemovalTime = phase.lap();
+
+  statistics.nRemovedDeadEnds = removeDeadEnds(installed, changedDsts, false, m_nThreads);
+  statistics.deadEndRemovalTime = phase.lap();
+
+  // Prefixes with a changed origin:
+  std::vector<const PrefixOrigins::value_type*> changedPrefixes;
+  for (const auto& origins : state.prefixOrigins) {
+    if (std::any_of(origins.first.begin(), origins.first.end(),
+                    [&] (int dstId) { return isChangedDst[dstId]; })) {
+      changedPrefixes.push_back(&origins);
+    }
+  }
+
+  // 5. Apply the difference to the real FIBs (the statistics count the routes of the changed
+  // dsts):
+  std::vector<FibHelper::Route> added;
+  std::vector<FibHelper::Route> removed;
+  std::vector<FibHelper::RouteGroup> changed;
+  std::map<nfd::FaceId, FibHelper::NextHop> oldEntry;
+  std::map<nfd::FaceId, FibHelper::NextHop> newEntry;
+  for (const auto& nodeEntry : installed) {
+    int nodeId = nodeEntry.first;
+    const auto faces = getNeighborFaces(*state.graph, nodeId);
+    added.clear();
+    removed.clear();
+    changed.clear();
+
+    Ptr<Node> node = NodeList::GetNode(static_cast<uint32_t>(nodeId));
+    Ptr<SplitWeightTable> weights;
+    if (m_isLfidSplitWeights) {
+      weights = SplitWeightTable::Get(node);
+    }
+
+    for (int dstId : changedDsts) {
+      if (!nodeEntry.second.contains(dstId)) {
+        continue;
+      }
+      VertexId dst = state.graph->getVertex(static_cast<uint32_t>(dstId));
+      changed.push_back({state.graph->getPrefixes(dst), {}});
+      for (const auto& nh : nodeEntry.second.getNhs(dstId)) {
+        changed.back().nextHops.push_back({faces.at(nh.getNhId()), nh.getCost()});
+        if (nh.getType() == NextHopType::UPWARD) {
+          statistics.nUpwardNextHops++;
+        }
+      }
+    }
+
+    // The difference of each FIB entry, merged over all origins of its prefix, so that a next
+    // hop is only removed if no origin uses it any more. Nexthops with new cost are added again
+    // (which updates the cost):
+    for (const auto* origins : changedPrefixes) {
+      getEntryNextHops(state.installed.at(nodeId), origins->first, faces, oldEntry);
+      getEntryNextHops(nodeEntry.second, origins->first, faces, newEntry);
+      for (const Name& prefix : origins->second) {
+        for (const auto& nh : oldEntry) {
+          if (newEntry.count(nh.first) == 0) {
+            removed.push_back({prefix, nh.second.face, nh.second.metric});
+          }
+        }
+        for (const auto& nh : newEntry) {
+          auto old = oldEntry.find(nh.first);
+          if (old == oldEntry.end() || old->second.metric != nh.second.metric) {
+            added.push_back({prefix, nh.second.face, nh.second.metric});
+          }
+        }
+      }
+    }
+
+    statistics.addRoutes(changed);
+
+    // Weights over the nexthops of all origins of each prefix:
+    if (weights != nullptr) {
+      for (const auto* origins : changedPrefixes) {
+        auto list = computeSplitWeights(installed, nodeEntry.second, origins->first, faces,
+                                        m_lfidSplitWeightExponent);
+        if (list != nullptr) {
+          weights->set(origins->second, list);
+        }
+        else {
+          for (const Name& prefix : origins->second) {
+            weights->erase(prefix);
+          }
+        }
+      }
+    }
+
+    FibHelper::RemoveRoutes(node, removed);
+    FibHelper::AddRoutes(node, added);
+  }
+
+  state.candidates = std::move(candidates);
+  state.installed = std::move(installed);
+  statistics.installTime = phase.lap();
+  PublishStatistics(statistics, total);
+}
+
+} // namespace ndn
+} // namespace ns3
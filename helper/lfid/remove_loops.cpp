@@ -18,58 +18,29 @@
  * Author: Klaus Schneider <klaus@cs.arizona.edu>
  */
 
-#include <queue>
-
-#include <boost/graph/graph_utility.hpp>
-#include <boost/graph/graph_traits.hpp>
-#include <boost/graph/properties.hpp>
-#include <boost/ref.hpp>
-#include <boost/graph/breadth_first_search.hpp>
-#include <boost/graph/visitors.hpp>
-
-#include <boost/graph/graph_traits.hpp>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
-#include <boost/property_map/property_map.hpp>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <tuple>
+#include <unordered_set>
 
 #include "remove_loops.hpp"
 #include "AbsFib.hpp"
+#include "FibGraph.hpp"
+
+#include "utils/parallel-for.hpp"
 
 namespace ns3 {
 namespace ndn {
 
 using std::cout;
-using std::set;
 using Fib = AbsFib;
 
-/*
- * Fill directed graph only with edges existing in the FIB.
- */
-void getDigraphFromFib(DiGraph &dg, const AllNodeFib &allNodeFIB,
-    const int dstId) {
-
-  // 1. Erase All Arcs:
-  dg.clear();
-
-  // 2. Add Arcs from FIB
-  for (const auto& node : allNodeFIB) {
-    int nodeId = node.first;
-    if (dstId == nodeId) {
-      continue;
-    }
-
-    for (const auto &fibNh : node.second.getNhs(dstId)) {
-      assert(fibNh.getType() <= NextHopType::UPWARD);
-      boost::add_edge(static_cast<uint64_t>(nodeId), static_cast<uint64_t>(fibNh.getNhId()), 1, dg);
-    }
-  }
-}
-
-
 class NodePrio {
 public:
-    NodePrio(int nodeId, int remainingNh, set<FibNextHop> nhSet)
-			: m_nodeId {nodeId}, m_remainingNh {remainingNh}, uwSet {nhSet}
+    NodePrio(int nodeId, int remainingNh, const AbsFib::UpwardNhRange& nhSet)
+			: m_nodeId {nodeId}, m_remainingNh {remainingNh}, uwSet(nhSet.begin(), nhSet.end())
 	{
 	  assert(remainingNh > 0 && uwSet.size() > 0);
 	  assert(static_cast<int>(uwSet.size()) < remainingNh);
@@ -93,8 +64,9 @@ public:
 
 	// Setters:
     FibNextHop popHighestCostUw() {
-      const FibNextHop& tmp = getHighestCostUw();
-      eraseUw(tmp);
+      assert(uwSet.size() > 0);
+      FibNextHop tmp = uwSet.back();
+      uwSet.pop_back();
       return tmp;
     }
 
@@ -105,22 +77,16 @@ public:
 	}
 
 private:
-    void eraseUw(FibNextHop nh) {
-        assert(uwSet.size() > 0);
-        auto success = uwSet.erase(nh);
-        assert(success == 1);
-    }
-
-    FibNextHop getHighestCostUw() const {
+    const FibNextHop& getHighestCostUw() const {
       assert(uwSet.size() > 0);
-      assert(std::prev(uwSet.end()) != uwSet.end());
-      return *(std::prev(uwSet.end()));
+      return uwSet.back();
     }
 
 private:
 	int m_nodeId;
 	int m_remainingNh;
-	set<FibNextHop> uwSet;
+	// Sorted ascending, as in the FIB.
+	std::vector<FibNextHop> uwSet;
 	friend std::ostream& operator<<(std::ostream&,  const NodePrio &node);
 };
 
@@ -130,28 +96,22 @@ std::ostream& operator<< (std::ostream& os, const NodePrio &node) {
 }
 
 
-int removeLoops(AllNodeFib &allNodeFIB, bool printOutput) {
-  (void)printOutput;
-  int removedLoopCounter = 0;
-  int upwardCounter = 0;
-
-  const int NUM_NODES {static_cast<int>(allNodeFIB.size())};
-
-  // Build graph with boost graph library:
-  DiGraph dg{};
+/*
+ * Loop removal for one dst at a time. The per-dst state is kept for the next dst.
+ */
+class LoopRemover {
+public:
+  /*
+   * Returns number of removed looping nexthops, adds all UW nexthops to upwardCounter.
+   */
+  int run(AllNodeFib &allNodeFIB, int dstId, int &upwardCounter) {
+    int removedLoopCounter = 0;
 
-  // Add all Arcs that fit into FIB. // O(n)
-  for (int dstId = 0; dstId < NUM_NODES; dstId++) {
     // 1. Get DiGraph from Fib //
-    getDigraphFromFib(dg, allNodeFIB, dstId);
-
-    // Maybe use for optimization:
-    // ArcMap arcMap = getArcMap(dg);
-
-    // NodeId -> set<UwNexthops>
-    std::priority_queue<NodePrio> q;
+    dg.assign(allNodeFIB, dstId);
 
     // 2. Put nodes in the queue, ordered by # remaining nexthops, then CostDelta // O(n^2)
+    assert(q.empty());
     for (const auto& node : allNodeFIB) {
       int nodeId {node.first};
       const Fib &fib {node.second};
@@ -159,57 +119,26 @@ int removeLoops(AllNodeFib &allNodeFIB, bool printOutput) {
         continue;
       }
 
-      const auto& uwNhSet = fib.getUpwardNhs(dstId);
-      if (!uwNhSet.empty()) {
-        upwardCounter += uwNhSet.size();
-
+      const int numUw {fib.numTypePerDst(dstId, NextHopType::UPWARD)};
+      if (numUw > 0) {
+        upwardCounter += numUw;
         int fibSize {fib.numEnabledNhPerDst(dstId)};
-        // NodePrio tmpNode {nodeId, fibSize, uwNhSet};
-        q.emplace(nodeId, fibSize, uwNhSet);
+        q.emplace_back(nodeId, fibSize, fib.getUpwardNhs(dstId));
       }
     }
+    std::make_heap(q.begin(), q.end());
 
     // 3. Iterate PriorityQueue //
     while (!q.empty()) {
-      NodePrio node = q.top();
-      q.pop();
+      std::pop_heap(q.begin(), q.end());
+      NodePrio &node = q.back();
 
       int nodeId = node.getId();
       int nhId = node.popHighestCostUw().getNhId();
 
-      // Remove opposite of Uphill link
-//      int arcId1 {getArcId(arcMap, nhId, nodeId)};
-      auto res = boost::edge(static_cast<uint64_t>(nhId), static_cast<uint64_t>(nodeId), dg);
-
-      auto arc = res.first;
-      bool arcExists = res.second;
-
-      if (arcExists) {
-        boost::remove_edge(arc, dg);
-//        dg.erase(dg.arcFromId(arcId1));
-//        arcMap.erase({nhId, nodeId});
-      }
-
-      // 2. Loop Check: Is the current node still reachable for the uphill nexthop?
-      // Uses BFS:
-      // bool willLoop = bfs(dg).run(dg.nodeFromId(nhId), dg.nodeFromId(nodeId)); // O(m^2n)
-
-      std::vector<int> dists(num_vertices(dg));
-
-      auto weightmap = get(boost::edge_weight, dg);
-
-      const auto& x = boost::edges(dg);
-      for(auto e = x.first; e != x.second; e++){
-        int weight = get(weightmap, *e);
-        assert(weight == 1); // Only use uniform weights.
-      }
-
-      // TODO: Could be replaced by BFS/DFS to improve speed.
-      boost::dijkstra_shortest_paths(dg, static_cast<uint64_t>(nhId),
-          distance_map(boost::make_iterator_property_map(dists.begin(), get(boost::vertex_index, dg)))
-      );
-
-      bool willLoop = (dists.at(static_cast<size_t>(nodeId)) < (std::numeric_limits<int>::max()-1));
+      // Loop Check: Is the current node still reachable for the uphill nexthop, not counting
+      // the opposite of the uphill link?
+      bool willLoop = dg.isReachable(nhId, nodeId);
 
       // Uphill nexthop loops back to original node
       if (willLoop) {
@@ -220,79 +149,129 @@ int removeLoops(AllNodeFib &allNodeFIB, bool printOutput) {
         allNodeFIB.at(node.getId()).erase(dstId, nhId);
 
         // Erase UW nexthop from Digraph:
-//        int arcId2 = getArcId(arcMap, node.getId(), nhId);
-//        assert(arcId2 >=0);
-
-        auto res2 = boost::edge(static_cast<uint64_t>(node.getId()), static_cast<uint64_t>(nhId), dg);
-        auto arc2 = res2.first;
-        assert(res.second);
-
-        boost::remove_edge(arc2, dg);
-
-//        dg.erase(dg.arcFromId(arcId2));
-//        arcMap.erase({node.getId(), nhId});
-      }
-
-      // Add opposite of UW link back:
-      if (arcExists) {
-        boost::add_edge(static_cast<uint64_t>(nhId), static_cast<uint64_t>(nodeId), 1, dg);
-//        auto arc = dg.addArc(dg.nodeFromId(nhId), dg.nodeFromId(nodeId));
-//        arcMap.emplace(std::make_pair(nhId, nodeId), dg.id(arc));
+        dg.removeArc(node.getId(), nhId);
       }
 
       // If not has further UW nexthops: Requeue.
       if (node.getRemainingUw() > 0) {
-        q.push(node);
+        std::push_heap(q.begin(), q.end());
+      }
+      else {
+        q.pop_back();
       }
     }
+
+    return removedLoopCounter;
   }
 
+private:
+  // Graph of all FIB entries towards the current dst:
+  FibGraph dg{};
+  // Max-heap of NodePrio:
+  std::vector<NodePrio> q;
+};
+
+static std::vector<int> getAllDsts(const AllNodeFib &allNodeFIB) {
+  // All AbsFibs share the same dsts:
+  if (allNodeFIB.empty()) {
+    return {};
+  }
+  return allNodeFIB.begin()->second.getDstIds();
+}
+
+int removeLoops(AllNodeFib &allNodeFIB, bool printOutput, uint32_t nThreads, int *nUpward) {
+  return removeLoops(allNodeFIB, getAllDsts(allNodeFIB), printOutput, nThreads, nUpward);
+}
+
+int removeLoops(AllNodeFib &allNodeFIB, const std::vector<int> &dstIds, bool printOutput,
+    uint32_t nThreads, int *nUpward) {
+  // Each dst only touches its own FIB entries, so dsts are independent. Per-dst counters are
+  // summed up afterwards, so the result does not depend on the number of threads.
+  std::vector<LoopRemover> workers(GetNumWorkerThreads(nThreads));
+  std::vector<int> removed(dstIds.size(), 0);
+  std::vector<int> upward(dstIds.size(), 0);
+
+  ParallelForWorkers(dstIds.size(), nThreads, [&] (uint32_t worker, size_t i) {
+    removed[i] = workers[worker].run(allNodeFIB, dstIds[i], upward[i]);
+  });
+
+  int removedLoopCounter = std::accumulate(removed.begin(), removed.end(), 0);
+  int upwardCounter = std::accumulate(upward.begin(), upward.end(), 0);
+
   if (printOutput) {
     std::cout << "Found " << upwardCounter << " UW nexthops, Removed " << removedLoopCounter
         << " Looping UwNhs, Remaining: " << upwardCounter - removedLoopCounter << " NHs\n";
   }
   assert((upwardCounter - removedLoopCounter) >= 0);
+  if (nUpward != nullptr) {
+    *nUpward = upwardCounter;
+  }
 
   return removedLoopCounter;
 }
 
 
-int removeDeadEnds(AllNodeFib &allNodeFIB, bool printOutput) {
-  int NUM_NODES {static_cast<int>(allNodeFIB.size())};
-  int checkedUwCounter {0};
-  int uwCounter {0};
-  int removedDeCounter {0};
+/*
+ * Worklist entry for removeDeadEnds: Uphill nexthop nh at node nodeId.
+ * Processed in ascending order of (nodeId, nh).
+ */
+struct DeadEndCandidate {
+  int nodeId;
+  FibNextHop nh;
+
+  bool operator>(const DeadEndCandidate& other) const {
+    return other.nodeId < nodeId || (other.nodeId == nodeId && other.nh < nh);
+  }
+};
+
+/*
+ * Dead end removal for one dst at a time. The worklist is kept for the next dst.
+ */
+class DeadEndRemover {
+public:
+  struct Counters {
+    int checkedUw {0};
+    int uw {0};
+    int removedDe {0};
+  };
+
+  Counters run(AllNodeFib &allNodeFIB, int dstId) {
+    Counters counters;
+
+    auto push = [&] (int nodeId, const FibNextHop& nh) {
+      if (queued.insert(getKey(nodeId, nh.getNhId())).second) {
+        worklist.push_back({nodeId, nh});
+        std::push_heap(worklist.begin(), worklist.end(), std::greater<DeadEndCandidate>());
+      }
+    };
 
-  for (int dstId = 0; dstId < NUM_NODES; dstId++) {
-    // NodeId -> FibNexthops (Order important)
-    set<std::pair<int, FibNextHop>> nhSet;
+    assert(worklist.empty() && queued.empty());
 
-    // 1. Put all uwNexthops in set<NodeId, FibNexhtop>:
+    // 1. Put all uwNexthops in the worklist:
     for (const auto& node : allNodeFIB) {
       int nodeId {node.first};
       if (nodeId == dstId) {
         continue;
       }
 
-      const auto& uwNhSet = node.second.getUpwardNhs(dstId);
-      uwCounter+= uwNhSet.size();
-      for (const FibNextHop &fibNh : uwNhSet) {
-        nhSet.emplace(nodeId, fibNh);
+      counters.uw += node.second.numTypePerDst(dstId, NextHopType::UPWARD);
+      for (const FibNextHop &fibNh : node.second.getUpwardNhs(dstId)) {
+        push(nodeId, fibNh);
       }
     }
 
-    // FibNexthops ordered by (costDelta, cost, nhId).
-    // Start with nexthop with highest cost:
-    while (!nhSet.empty()) {
-      checkedUwCounter++;
+    // FibNexthops ordered by (nodeId, costDelta, cost, nhId).
+    while (!worklist.empty()) {
+      counters.checkedUw++;
 
       // Pop from queue:
-      const auto &nhPair = nhSet.begin();
-      assert(nhPair != nhSet.end());
-      nhSet.erase(nhPair);
+      std::pop_heap(worklist.begin(), worklist.end(), std::greater<DeadEndCandidate>());
+      const DeadEndCandidate candidate = worklist.back();
+      worklist.pop_back();
 
-      int nodeId = nhPair->first;
-      const FibNextHop &nh = nhPair->second;
+      int nodeId = candidate.nodeId;
+      const FibNextHop &nh = candidate.nh;
+      queued.erase(getKey(nodeId, nh.getNhId()));
       Fib& fib = allNodeFIB.at(nodeId);
 
       if (nh.getNhId() == dstId) {
@@ -307,24 +286,18 @@ int removeDeadEnds(AllNodeFib &allNodeFIB, bool printOutput) {
       // If it has exactly 1 entry -> Is downward back through the upward nexthop!
       // Higher O-Complexity below:
       if (reverseEntries <= 1) {
-        removedDeCounter++;
+        counters.removedDe++;
 
         // Erase NhEntry from FIB:
         fib.erase(dstId, nh.getNhId());
 
         // Push into Queue: All NhEntries that lead to m_nodeId!
-        const auto &nexthops = fib.getNhs(dstId);
-
-        for (const auto& ownNhs : nexthops) {
+        for (const auto& ownNhs : fib.getNhs(dstId)) {
           if (ownNhs.getType() == NextHopType::DW && ownNhs.getNhId() != dstId) {
-            const auto &reverseNh = allNodeFIB.at(ownNhs.getNhId()).getNhs(dstId);
-
-            for (const auto& y : reverseNh) {
+            for (const auto& y : allNodeFIB.at(ownNhs.getNhId()).getNhs(dstId)) {
               if (y.getNhId() == nodeId) {
                 assert(y.getType() == NextHopType::UPWARD);
-//                cout << "Dst: " << dstId << ", Node " << ownNhs.getNhId() << " Pushing nh: "
-//                    << y << "!\n";
-                nhSet.emplace(ownNhs.getNhId(), y);
+                push(ownNhs.getNhId(), y);
                 break;
               }
             }
@@ -332,6 +305,42 @@ int removeDeadEnds(AllNodeFib &allNodeFIB, bool printOutput) {
         }
       }
     }
+
+    return counters;
+  }
+
+private:
+  static uint64_t getKey(int nodeId, int nhId) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(nodeId)) << 32 | static_cast<uint32_t>(nhId);
+  }
+
+private:
+  // Flat worklist (min-heap):
+  std::vector<DeadEndCandidate> worklist;
+  // (NodeId, NhId) pairs currently in the worklist:
+  std::unordered_set<uint64_t> queued;
+};
+
+int removeDeadEnds(AllNodeFib &allNodeFIB, bool printOutput, uint32_t nThreads) {
+  return removeDeadEnds(allNodeFIB, getAllDsts(allNodeFIB), printOutput, nThreads);
+}
+
+int removeDeadEnds(AllNodeFib &allNodeFIB, const std::vector<int> &dstIds, bool printOutput,
+    uint32_t nThreads) {
+  std::vector<DeadEndRemover> workers(GetNumWorkerThreads(nThreads));
+  std::vector<DeadEndRemover::Counters> counters(dstIds.size());
+
+  ParallelForWorkers(dstIds.size(), nThreads, [&] (uint32_t worker, size_t i) {
+    counters[i] = workers[worker].run(allNodeFIB, dstIds[i]);
+  });
+
+  int checkedUwCounter {0};
+  int uwCounter {0};
+  int removedDeCounter {0};
+  for (const auto& c : counters) {
+    checkedUwCounter += c.checkedUw;
+    uwCounter += c.uw;
+    removedDeCounter += c.removedDe;
   }
 
   if (printOutput) {
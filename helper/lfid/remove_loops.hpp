@@ -20,7 +20,8 @@
 
 #pragma once
 
-#include <boost/graph/adjacency_list.hpp>
+#include <cstdint>
+#include <vector>
 
 #include "AbsFib.hpp"
 
@@ -30,16 +31,25 @@ namespace ndn {
 class ArcMap;
 using AllNodeFib = std::unordered_map<int, AbsFib>;
 
-// No Vertex Property
-// Edge Property: Weight.
-using DiGraph = boost::adjacency_list<boost::listS, boost::vecS, boost::bidirectionalS,
-    boost::no_property, boost::property<boost::edge_weight_t, int>>;
+/*
+ * Both passes handle each dst of the AbsFibs (see DstIndex) independently, using up to nThreads
+ * threads (0: all hardware threads). The result is the same for any number of threads.
+ * Return the number of removed nexthops; removeLoops also reports the number of upward nexthops
+ * it found in nUpward, if given.
+ */
+int removeLoops(AllNodeFib &allNodeFIB, bool printOutput = false, uint32_t nThreads = 1,
+    int *nUpward = nullptr);
 
-void getDigraphFromFib(DiGraph &dg, const AllNodeFib &allNodeFIB, const int dstId);
+int removeDeadEnds(AllNodeFib &allNodeFIB, bool printOutput = false, uint32_t nThreads = 1);
 
-int removeLoops(AllNodeFib &allNodeFIB, bool printOutput = true);
+/*
+ * Same, but only for the given dsts. Entries of other dsts are left unchanged.
+ */
+int removeLoops(AllNodeFib &allNodeFIB, const std::vector<int> &dstIds, bool printOutput = false,
+    uint32_t nThreads = 1, int *nUpward = nullptr);
 
-int removeDeadEnds(AllNodeFib &allNodeFIB, bool printOutput = true);
+int removeDeadEnds(AllNodeFib &allNodeFIB, const std::vector<int> &dstIds,
+    bool printOutput = false, uint32_t nThreads = 1);
 
 } // namespace ndn
 } // namespace ns3
\ No newline at end of file
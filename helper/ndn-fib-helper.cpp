@@ -39,6 +39,8 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/table/fib.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
@@ -47,6 +49,8 @@ namespace ndn {
 
 NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 
+bool FibHelper::m_directFibInstall = true;
+
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
@@ -169,6 +173,108 @@ FibHelper::AddRoute(const std::string& nodeName, const Name& prefix,
   AddRoute(node, prefix, otherNode, metric);
 }
 
+void
+FibHelper::AddRoutes(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  if (!m_directFibInstall) {
+    for (const auto& route : routes) {
+      AddRoute(node, route.prefix, route.face, route.metric);
+    }
+    return;
+  }
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  // Same as FibManager::addNextHop, without the command
+  nfd::Fib& fib = ndn->getForwarder()->getFib();
+  for (const auto& route : routes) {
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << route.prefix << " via "
+                     << route.face->getLocalUri() << " metric " << route.metric);
+    NS_ASSERT_MSG(ndn->getFaceById(route.face->getId()) == route.face,
+                  "Face " << route.face->getId() << " does not belong to node ["
+                          << node->GetId() << "]");
+
+    fib.insert(route.prefix).first->addOrUpdateNextHop(*route.face, 0,
+                                                       static_cast<uint64_t>(route.metric));
+  }
+}
+
+void
+FibHelper::AddRoutes(Ptr<Node> node, const std::vector<RouteGroup>& groups)
+{
+  if (!m_directFibInstall) {
+    for (const auto& group : groups) {
+      for (const auto& prefix : *group.prefixes) {
+        for (const auto& nextHop : group.nextHops) {
+          AddRoute(node, prefix, nextHop.face, nextHop.metric);
+        }
+      }
+    }
+    return;
+  }
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  nfd::Fib& fib = ndn->getForwarder()->getFib();
+  for (const auto& group : groups) {
+    if (group.nextHops.empty())
+      continue;
+
+    for (const auto& nextHop : group.nextHops) {
+      NS_ASSERT_MSG(ndn->getFaceById(nextHop.face->getId()) == nextHop.face,
+                    "Face " << nextHop.face->getId() << " does not belong to node ["
+                            << node->GetId() << "]");
+    }
+
+    for (const auto& prefix : *group.prefixes) {
+      nfd::fib::Entry* entry = fib.insert(prefix).first;
+      for (const auto& nextHop : group.nextHops) {
+        NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << prefix << " via "
+                         << nextHop.face->getLocalUri() << " metric " << nextHop.metric);
+        entry->addOrUpdateNextHop(*nextHop.face, 0, static_cast<uint64_t>(nextHop.metric));
+      }
+    }
+  }
+}
+
+void
+FibHelper::RemoveRoutes(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  if (!m_directFibInstall) {
+    for (const auto& route : routes) {
+      RemoveRoute(node, route.prefix, route.face);
+    }
+    return;
+  }
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+
+  // Same as FibManager::removeNextHop, without the command
+  nfd::Fib& fib = ndn->getForwarder()->getFib();
+  for (const auto& route : routes) {
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route del " << route.prefix << " via "
+                     << route.face->getLocalUri());
+
+    nfd::fib::Entry* entry = fib.findExactMatch(route.prefix);
+    if (entry == nullptr)
+      continue;
+
+    entry->removeNextHop(*route.face, 0);
+    if (!entry->hasNextHops()) {
+      fib.erase(*entry);
+    }
+  }
+}
+
+void
+FibHelper::SetDirectFibInstall(bool enable)
+{
+  m_directFibInstall = enable;
+}
+
 void
 FibHelper::RemoveRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face)
 {
@@ -28,6 +28,8 @@
 
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
 
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -43,6 +45,39 @@ using ::ndn::nfd::ControlParameters;
  */
 class FibHelper {
 public:
+  /**
+   * @brief Forwarding entry for AddRoutes()
+   */
+  struct Route
+  {
+    Name prefix;
+    shared_ptr<Face> face;
+    int32_t metric;
+  };
+
+  /**
+   * @brief Next hop of a RouteGroup
+   */
+  struct NextHop
+  {
+    shared_ptr<Face> face;
+    int32_t metric;
+  };
+
+  /**
+   * @brief Forwarding entries for AddRoutes() that share the same next hops
+   *
+   * Route calculations compute one group per destination and attach it to the prefix list of
+   * the destination, which is shared by the groups of all nodes.  Thus, the routes of a node
+   * take memory proportional to the number of destinations and next hops, independent of the
+   * number of prefixes.
+   */
+  struct RouteGroup
+  {
+    shared_ptr<const std::vector<Name>> prefixes;
+    std::vector<NextHop> nextHops;
+  };
+
   /**
    * \brief Add forwarding entry to FIB
    *
@@ -100,6 +135,57 @@ public:
   AddRoute(const std::string& nodeName, const Name& prefix, const std::string& otherNodeName,
            int32_t metric);
 
+  /**
+   * \brief Add a batch of forwarding entries to FIB
+   *
+   * By default, the next hops are inserted directly into the forwarder's FIB.  This results
+   * in the same FIB as calling AddRoute() for each route, but avoids encoding, signing, and
+   * dispatching one FIB management command per route.  Unlike commands, which are processed
+   * once the simulation runs, the routes are installed immediately.
+   *
+   * \param node   Node
+   * \param routes Forwarding entries (prefix, face of the node, metric)
+   *
+   * \see SetDirectFibInstall
+   */
+  static void
+  AddRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+
+  /**
+   * \brief Add forwarding entries to FIB for every prefix and next hop of each group
+   *
+   * Same result as AddRoutes() with one route per prefix and next hop (in group order, then
+   * prefix order, then next-hop order).  With direct installation, each prefix is looked up
+   * in the FIB once per group instead of once per next hop.
+   *
+   * \param node   Node
+   * \param groups Prefixes and their next hops (faces of the node, metrics)
+   */
+  static void
+  AddRoutes(Ptr<Node> node, const std::vector<RouteGroup>& groups);
+
+  /**
+   * \brief Remove a batch of forwarding entries from FIB
+   *
+   * Counterpart of AddRoutes(): same result as calling RemoveRoute() for each route (the
+   * metric is ignored), using the same installation mode.
+   *
+   * \param node   Node
+   * \param routes Forwarding entries (prefix, face of the node)
+   */
+  static void
+  RemoveRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+
+  /**
+   * \brief Choose how AddRoutes() and RemoveRoutes() install forwarding entries
+   *
+   * \param enable If true (default), insert directly into the forwarder's FIB.  If false,
+   *               send one FIB management command per route, same as AddRoute() (e.g., for
+   *               scenarios that exercise the FIB manager).
+   */
+  static void
+  SetDirectFibInstall(bool enable);
+
   /**
    * \brief remove forwarding entry in FIB
    *
@@ -159,6 +245,9 @@ private:
 
   static void
   RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node);
+
+private:
+  static bool m_directFibInstall;
 };
 
 } // namespace ndn
@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-fib-loop-verifier.hpp"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-net-device-transport.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/table/fib.hpp"
+
+#include "ns3/channel.h"
+#include "ns3/names.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+
+#include <algorithm>
+#include <ostream>
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+FibLoopVerifier::FibLoopVerifier()
+  : m_fibs(NodeList::GetNNodes(), nullptr)
+{
+  m_facesBegin.reserve(NodeList::GetNNodes() + 1);
+  for (uint32_t node = 0; node < NodeList::GetNNodes(); node++) {
+    m_facesBegin.push_back(m_faces.size());
+
+    Ptr<L3Protocol> ndn = NodeList::GetNode(node)->GetObject<L3Protocol>();
+    if (ndn == nullptr)
+      continue;
+
+    m_fibs[node] = &ndn->getForwarder()->getFib();
+    size_t facesBegin = m_faces.size();
+    for (const Face& face : ndn->getForwarder()->getFaceTable()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
+      if (transport == nullptr)
+        continue;
+
+      Ptr<NetDevice> device = transport->GetNetDevice();
+      Ptr<Channel> channel = device->GetChannel();
+      if (channel == nullptr)
+        continue;
+
+      FaceLinks links{face.getId(), static_cast<uint32_t>(m_links.size()), 0};
+      for (size_t i = 0; i < channel->GetNDevices(); i++) {
+        Ptr<NetDevice> otherDevice = channel->GetDevice(i);
+        if (otherDevice == device)
+          continue;
+
+        Ptr<L3Protocol> otherNdn = otherDevice->GetNode()->GetObject<L3Protocol>();
+        if (otherNdn == nullptr)
+          continue;
+
+        shared_ptr<Face> otherFace = otherNdn->getFaceByNetDevice(otherDevice);
+        if (otherFace != nullptr) {
+          m_links.push_back({otherDevice->GetNode()->GetId(), otherFace->getId()});
+        }
+      }
+      links.linksEnd = m_links.size();
+      m_faces.push_back(links);
+    }
+    std::sort(m_faces.begin() + facesBegin, m_faces.end(),
+              [] (const FaceLinks& a, const FaceLinks& b) { return a.face < b.face; });
+  }
+  m_facesBegin.push_back(m_faces.size());
+}
+
+const FibLoopVerifier::FaceLinks*
+FibLoopVerifier::findFace(uint32_t node, nfd::FaceId face) const
+{
+  auto begin = m_faces.begin() + m_facesBegin[node];
+  auto end = m_faces.begin() + m_facesBegin[node + 1];
+  auto it = std::lower_bound(begin, end, face,
+                             [] (const FaceLinks& links, nfd::FaceId id) {
+                               return links.face < id;
+                             });
+  return it != end && it->face == face ? &*it : nullptr;
+}
+
+void
+FibLoopVerifier::buildArcs(const Name& prefix)
+{
+  m_arcsBegin.clear();
+  m_arcs.clear();
+  for (uint32_t node = 0; node < m_fibs.size(); node++) {
+    m_arcsBegin.push_back(m_arcs.size());
+    if (m_fibs[node] == nullptr)
+      continue;
+
+    const nfd::fib::Entry& entry = m_fibs[node]->findLongestPrefixMatch(prefix);
+    for (const auto& nextHop : entry.getNextHops()) {
+      nfd::FaceId outFace = nextHop.getFace().getId();
+      const FaceLinks* links = findFace(node, outFace);
+      if (links == nullptr)
+        continue; // e.g., application face
+
+      for (uint32_t link = links->linksBegin; link != links->linksEnd; link++) {
+        m_arcs.push_back({node, m_links[link].node, outFace, m_links[link].inFace});
+      }
+    }
+  }
+  m_arcsBegin.push_back(m_arcs.size());
+}
+
+void
+FibLoopVerifier::searchCycles(const Name& prefix, std::vector<Loop>& loops)
+{
+  // Iterative depth-first search over the arcs: arc a leads to all arcs of node m_arcs[a].to
+  // except those leaving over the face it came in.  A cycle of arcs is a forwarding loop.
+  enum : uint8_t { WHITE, GRAY, BLACK };
+  m_colors.assign(m_arcs.size(), WHITE);
+  m_stackPositions.resize(m_arcs.size());
+
+  for (uint32_t root = 0; root < m_arcs.size(); root++) {
+    if (m_colors[root] != WHITE)
+      continue;
+
+    // (arc, next successor of the arc to look at)
+    m_stack.assign(1, {root, m_arcsBegin[m_arcs[root].to]});
+    m_colors[root] = GRAY;
+    m_stackPositions[root] = 0;
+
+    while (!m_stack.empty()) {
+      uint32_t arc = m_stack.back().first;
+      uint32_t& next = m_stack.back().second;
+      const Arc& current = m_arcs[arc];
+
+      if (next == m_arcsBegin[current.to + 1]) {
+        m_colors[arc] = BLACK;
+        m_stack.pop_back();
+        continue;
+      }
+
+      uint32_t successor = next++;
+      if (m_arcs[successor].outFace == current.inFace)
+        continue;
+
+      if (m_colors[successor] == GRAY) {
+        Loop loop{prefix, {}};
+        for (size_t i = m_stackPositions[successor]; i < m_stack.size(); i++) {
+          loop.nodes.push_back(m_arcs[m_stack[i].first].from);
+        }
+        loops.push_back(std::move(loop));
+      }
+      else if (m_colors[successor] == WHITE) {
+        m_colors[successor] = GRAY;
+        m_stackPositions[successor] = m_stack.size();
+        m_stack.emplace_back(successor, m_arcsBegin[m_arcs[successor].to]);
+      }
+    }
+  }
+}
+
+std::vector<FibLoopVerifier::Loop>
+FibLoopVerifier::findLoops(const Name& prefix)
+{
+  std::vector<Loop> loops;
+  buildArcs(prefix);
+  searchCycles(prefix, loops);
+  return loops;
+}
+
+std::vector<FibLoopVerifier::Loop>
+FibLoopVerifier::findLoops()
+{
+  std::set<Name> prefixes;
+  for (const nfd::fib::Fib* fib : m_fibs) {
+    if (fib == nullptr)
+      continue;
+
+    for (const auto& entry : *fib) {
+      if (entry.hasNextHops()) {
+        prefixes.insert(entry.getPrefix());
+      }
+    }
+  }
+
+  std::vector<Loop> loops;
+  for (const Name& prefix : prefixes) {
+    buildArcs(prefix);
+    searchCycles(prefix, loops);
+  }
+  return loops;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const FibLoopVerifier::Loop& loop)
+{
+  os << loop.prefix << ":";
+  for (uint32_t node : loop.nodes) {
+    std::string name = Names::FindName(NodeList::GetNode(node));
+    os << " " << (name.empty() ? std::to_string(node) : name) << " ->";
+  }
+  if (!loop.nodes.empty()) {
+    std::string name = Names::FindName(NodeList::GetNode(loop.nodes.front()));
+    os << " " << (name.empty() ? std::to_string(loop.nodes.front()) : name);
+  }
+  return os;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_FIB_LOOP_VERIFIER_H
+#define NDN_FIB_LOOP_VERIFIER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <iosfwd>
+#include <vector>
+
+namespace nfd {
+namespace fib {
+class Fib;
+} // namespace fib
+} // namespace nfd
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Checks the FIBs installed in the forwarders of all nodes for forwarding loops
+ *
+ * For a prefix, every node forwards along the next hops of its longest-prefix-match FIB entry,
+ * but never back out of the face the Interest came in (as NFD's forwarding strategies do).  A
+ * forwarding loop is a cycle in the resulting graph of (node, in-face) states, so next hops
+ * that point at each other over one link (e.g., an LFID upward and downward next hop) are not
+ * reported.  Next hops towards multi-access channels lead to all other nodes on the channel.
+ *
+ * The verifier takes a snapshot of the faces and links of all nodes on construction, while
+ * the FIB entries are read on every call.  A check is linear in the number of next hops on
+ * all nodes (times the node degree), and reports one cycle for every loop it runs into.
+ */
+class FibLoopVerifier : boost::noncopyable {
+public:
+  /**
+   * @brief Forwarding loop
+   */
+  struct Loop
+  {
+    Name prefix;
+    /// @brief IDs of the nodes in forwarding order; the last node forwards to the first one
+    std::vector<uint32_t> nodes;
+  };
+
+  /**
+   * @brief Take a snapshot of the faces of all nodes with an NDN stack
+   */
+  FibLoopVerifier();
+
+  /**
+   * @brief Find forwarding loops of Interests for @p prefix
+   */
+  std::vector<Loop>
+  findLoops(const Name& prefix);
+
+  /**
+   * @brief Find forwarding loops for the prefixes of all FIB entries of all nodes
+   */
+  std::vector<Loop>
+  findLoops();
+
+private:
+  struct Link
+  {
+    uint32_t node;
+    /// @brief Face of the neighbor node the link ends at
+    nfd::FaceId inFace;
+  };
+
+  struct FaceLinks
+  {
+    nfd::FaceId face;
+    uint32_t linksBegin;
+    uint32_t linksEnd;
+  };
+
+  struct Arc
+  {
+    uint32_t from;
+    uint32_t to;
+    nfd::FaceId outFace;
+    nfd::FaceId inFace;
+  };
+
+  const FaceLinks*
+  findFace(uint32_t node, nfd::FaceId face) const;
+
+  void
+  buildArcs(const Name& prefix);
+
+  void
+  searchCycles(const Name& prefix, std::vector<Loop>& loops);
+
+private:
+  /// @brief Forwarder FIB of every node, indexed by node ID (nullptr without NDN stack)
+  std::vector<const nfd::fib::Fib*> m_fibs;
+
+  /// @brief Faces of node i (sorted by face ID): [m_facesBegin[i], m_facesBegin[i + 1])
+  std::vector<uint32_t> m_facesBegin;
+  std::vector<FaceLinks> m_faces;
+  std::vector<Link> m_links;
+
+  /// @brief Arcs of node i (one per next hop and neighbor): [m_arcsBegin[i], m_arcsBegin[i + 1])
+  std::vector<uint32_t> m_arcsBegin;
+  std::vector<Arc> m_arcs;
+
+  // scratch buffers of searchCycles()
+  std::vector<uint8_t> m_colors;
+  std::vector<uint32_t> m_stackPositions;
+  std::vector<std::pair<uint32_t, uint32_t>> m_stack;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const FibLoopVerifier::Loop& loop);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_FIB_LOOP_VERIFIER_H
@@ -0,0 +1,589 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-graph.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/channel.h"
+#include "ns3/channel-list.h"
+
+#include "utils/parallel-for.hpp"
+
+#include <boost/graph/detail/d_ary_heap.hpp>
+#include <boost/property_map/property_map.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+constexpr GlobalRoutingGraph::VertexId GlobalRoutingGraph::INVALID_VERTEX;
+constexpr uint32_t GlobalRoutingGraph::INVALID_EDGE;
+constexpr uint32_t GlobalRoutingGraph::DISTANCE_INF;
+
+GlobalRoutingGraph::GlobalRoutingGraph()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr == 0)
+      continue;
+
+    uint32_t nodeId = (*node)->GetId();
+    if (m_nodeVertices.size() <= nodeId) {
+      m_nodeVertices.resize(nodeId + 1, INVALID_VERTEX);
+    }
+    m_nodeVertices[nodeId] = static_cast<VertexId>(m_routers.size());
+    m_routers.push_back(gr);
+    m_nodeIds.push_back(static_cast<int32_t>(nodeId));
+  }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr == 0)
+      continue;
+
+    m_routers.push_back(gr);
+    m_nodeIds.push_back(-1);
+  }
+
+  std::unordered_map<const GlobalRouter*, VertexId> vertexOf;
+  vertexOf.reserve(m_routers.size());
+  for (VertexId v = 0; v < m_routers.size(); v++) {
+    vertexOf.emplace(PeekPointer(m_routers[v]), v);
+  }
+
+  auto noPrefixes = make_shared<const std::vector<Name>>();
+  m_prefixes.reserve(m_routers.size());
+  for (const auto& gr : m_routers) {
+    if (gr->GetLocalPrefixes().empty()) {
+      m_prefixes.push_back(noPrefixes);
+      continue;
+    }
+    auto prefixes = make_shared<std::vector<Name>>();
+    prefixes->reserve(gr->GetLocalPrefixes().size());
+    for (const auto& prefix : gr->GetLocalPrefixes()) {
+      prefixes->push_back(*prefix);
+    }
+    m_prefixes.push_back(std::move(prefixes));
+  }
+
+  m_edgeOffsets.reserve(m_routers.size() + 1);
+  m_edgeOffsets.push_back(0);
+  for (const auto& gr : m_routers) {
+    for (const auto& incidency : gr->GetIncidencies()) {
+      auto target = vertexOf.find(PeekPointer(std::get<2>(incidency)));
+      if (target == vertexOf.end())
+        continue;
+
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      m_edgeTargets.push_back(target->second);
+      // face metrics are 16 bit, larger values are truncated
+      m_edgeWeights.push_back(face == nullptr ? 0 : static_cast<uint16_t>(face->getMetric()));
+      m_edgeFaces.push_back(face);
+    }
+    m_edgeOffsets.push_back(static_cast<uint32_t>(m_edgeTargets.size()));
+  }
+
+  // Reverse (in-edge) index
+  m_inEdgeOffsets.assign(m_routers.size() + 1, 0);
+  for (VertexId target : m_edgeTargets) {
+    m_inEdgeOffsets[target + 1]++;
+  }
+  for (size_t v = 0; v < m_routers.size(); v++) {
+    m_inEdgeOffsets[v + 1] += m_inEdgeOffsets[v];
+  }
+  m_inEdges.resize(m_edgeTargets.size());
+  m_inEdgeSources.resize(m_edgeTargets.size());
+  std::vector<uint32_t> position(m_inEdgeOffsets.begin(), m_inEdgeOffsets.end() - 1);
+  for (VertexId u = 0; u < m_routers.size(); u++) {
+    for (size_t e = edgesBegin(u); e != edgesEnd(u); e++) {
+      uint32_t i = position[m_edgeTargets[e]]++;
+      m_inEdges[i] = static_cast<uint32_t>(e);
+      m_inEdgeSources[i] = u;
+    }
+  }
+}
+
+void
+GlobalRoutingGraph::computeDistances(VertexId source, std::vector<uint32_t>& distances,
+                                     VertexId excluded) const
+{
+  runDijkstra(source, distances, nullptr, excluded, nullptr);
+}
+
+void
+GlobalRoutingGraph::computeFirstHops(VertexId source, std::vector<uint32_t>& distances,
+                                     std::vector<uint32_t>& firstEdges,
+                                     const std::vector<uint32_t>* sourceWeights) const
+{
+  runDijkstra(source, distances, &firstEdges, INVALID_VERTEX, sourceWeights);
+}
+
+void
+GlobalRoutingGraph::runDijkstra(VertexId source, std::vector<uint32_t>& distances,
+                                std::vector<uint32_t>* firstEdges, VertexId excluded,
+                                const std::vector<uint32_t>* sourceWeights) const
+{
+  distances.assign(m_routers.size(), DISTANCE_INF);
+  distances[source] = 0;
+  if (firstEdges != nullptr) {
+    firstEdges->assign(m_routers.size(), INVALID_EDGE);
+  }
+
+  ShortestPathQueue<uint32_t, VertexId> queue;
+  queue.push(0, source);
+
+  while (!queue.empty()) {
+    uint32_t distance = queue.top().first;
+    VertexId u = queue.top().second;
+    queue.pop();
+
+    if (distance != distances[u] || u == excluded)
+      continue;
+
+    for (size_t e = edgesBegin(u); e != edgesEnd(u); e++) {
+      VertexId v = m_edgeTargets[e];
+      uint32_t weight = m_edgeWeights[e];
+      if (u == source && sourceWeights != nullptr) {
+        weight = (*sourceWeights)[e - edgesBegin(source)];
+      }
+
+      uint32_t candidate = distance + weight;
+      if (candidate < distances[v]) {
+        distances[v] = candidate;
+        if (firstEdges != nullptr) {
+          (*firstEdges)[v] = u == source ? static_cast<uint32_t>(e) : (*firstEdges)[u];
+        }
+        queue.push(candidate, v);
+      }
+    }
+  }
+}
+
+void
+GlobalRoutingGraph::computeShortestPaths(VertexId source, ShortestPaths& paths,
+                                         const std::vector<uint32_t>* sourceWeights) const
+{
+  typedef boost::iterator_property_map<uint32_t*, boost::identity_property_map> DistanceMap;
+  typedef boost::iterator_property_map<size_t*, boost::identity_property_map> IndexInHeapMap;
+  enum Color : uint8_t { WHITE, GRAY, BLACK };
+
+  const size_t nVertices = m_routers.size();
+  std::vector<uint32_t>& distances = paths.distances;
+  distances.assign(nVertices, DISTANCE_INF);
+  paths.predecessors.assign(nVertices, INVALID_VERTEX);
+  paths.firstEdges.assign(nVertices, INVALID_EDGE);
+  distances[source] = 0;
+
+  std::vector<size_t> indexInHeap(nVertices);
+  std::vector<uint8_t> colors(nVertices, WHITE);
+  boost::d_ary_heap_indirect<VertexId, 4, IndexInHeapMap, DistanceMap, std::less<uint32_t>>
+    queue(DistanceMap(distances.data()), IndexInHeapMap(indexInHeap.data()));
+
+  // Same steps as boost::breadth_first_visit with dijkstra_bfs_visitor: a newly discovered
+  // vertex is queued even if the edge does not improve its distance.
+  colors[source] = GRAY;
+  queue.push(source);
+  while (!queue.empty()) {
+    VertexId u = queue.top();
+    queue.pop();
+
+    for (size_t e = edgesBegin(u); e != edgesEnd(u); e++) {
+      VertexId v = m_edgeTargets[e];
+      if (colors[v] == BLACK)
+        continue;
+
+      uint32_t weight = m_edgeWeights[e];
+      if (u == source && sourceWeights != nullptr) {
+        weight = (*sourceWeights)[e - edgesBegin(source)];
+      }
+
+      bool isDecreased = distances[u] + weight < distances[v];
+      if (isDecreased) {
+        distances[v] = distances[u] + weight;
+        paths.predecessors[v] = u;
+        paths.firstEdges[v] = u == source ? static_cast<uint32_t>(e) : paths.firstEdges[u];
+      }
+
+      if (colors[v] == WHITE) {
+        colors[v] = GRAY;
+        queue.push(v);
+      }
+      else if (isDecreased) {
+        queue.update(v);
+      }
+    }
+    colors[u] = BLACK;
+  }
+}
+
+void
+GlobalRoutingGraph::computeEqualCostFirstHops(VertexId source, EqualCostFirstHops& firstHops) const
+{
+  const size_t nVertices = m_routers.size();
+  std::vector<uint32_t>& distances = firstHops.distances;
+  runDijkstra(source, distances, nullptr, INVALID_VERTEX, nullptr);
+
+  const size_t nWords = (edgesEnd(source) - edgesBegin(source) + 63) / 64;
+  firstHops.nWords = nWords;
+  firstHops.bits.assign(nVertices * nWords, 0);
+  uint64_t* bits = firstHops.bits.data();
+
+  std::vector<VertexId> order;
+  order.reserve(nVertices);
+  for (VertexId v = 0; v < nVertices; v++) {
+    if (v != source && distances[v] < DISTANCE_INF) {
+      order.push_back(v);
+    }
+  }
+  std::sort(order.begin(), order.end(), [&distances] (VertexId a, VertexId b) {
+    return distances[a] < distances[b] || (distances[a] == distances[b] && a < b);
+  });
+
+  for (size_t begin = 0; begin != order.size();) {
+    size_t end = begin;
+    while (end != order.size() && distances[order[end]] == distances[order[begin]]) {
+      end++;
+    }
+
+    // Predecessors at a smaller distance are final already
+    for (size_t k = begin; k != end; k++) {
+      VertexId v = order[k];
+      for (size_t i = inEdgesBegin(v); i != inEdgesEnd(v); i++) {
+        VertexId u = m_inEdgeSources[i];
+        size_t e = m_inEdges[i];
+        if (distances[u] + m_edgeWeights[e] != distances[v])
+          continue;
+
+        if (u == source) {
+          size_t index = e - edgesBegin(source);
+          bits[v * nWords + index / 64] |= uint64_t(1) << (index % 64);
+        }
+        else if (distances[u] < distances[v]) {
+          for (size_t word = 0; word < nWords; word++) {
+            bits[v * nWords + word] |= bits[u * nWords + word];
+          }
+        }
+      }
+    }
+
+    // Zero-weight edges within the group (e.g., from channels): propagate until stable
+    bool isChanged = true;
+    while (isChanged) {
+      isChanged = false;
+      for (size_t k = begin; k != end; k++) {
+        VertexId v = order[k];
+        for (size_t i = inEdgesBegin(v); i != inEdgesEnd(v); i++) {
+          VertexId u = m_inEdgeSources[i];
+          if (u == source || m_edgeWeights[m_inEdges[i]] != 0 || distances[u] != distances[v])
+            continue;
+
+          for (size_t word = 0; word < nWords; word++) {
+            uint64_t merged = bits[v * nWords + word] | bits[u * nWords + word];
+            if (merged != bits[v * nWords + word]) {
+              bits[v * nWords + word] = merged;
+              isChanged = true;
+            }
+          }
+        }
+      }
+    }
+    begin = end;
+  }
+}
+
+bool
+GlobalRoutingGraph::hasSameEdges(const GlobalRoutingGraph& other) const
+{
+  return m_routers == other.m_routers && m_edgeOffsets == other.m_edgeOffsets
+    && m_edgeTargets == other.m_edgeTargets && m_edgeFaces == other.m_edgeFaces;
+}
+
+DistanceMatrix::DistanceMatrix(const GlobalRoutingGraph& graph, uint32_t nThreads)
+  : m_graph(&graph)
+  , m_nVertices(graph.getNVertices())
+  , m_distances(m_nVertices * m_nVertices)
+{
+  ParallelFor(m_nVertices, nThreads, [this] (size_t from) {
+    computeRow(static_cast<VertexId>(from));
+  });
+}
+
+void
+DistanceMatrix::computeRow(VertexId from)
+{
+  std::vector<uint32_t> distances;
+  m_graph->computeDistances(from, distances);
+  std::copy(distances.begin(), distances.end(), m_distances.begin() + from * m_nVertices);
+}
+
+size_t
+DistanceMatrix::update(const GlobalRoutingGraph& graph, uint32_t nThreads)
+{
+  NS_ASSERT(graph.hasSameEdges(*m_graph));
+  const uint32_t INF = GlobalRoutingGraph::DISTANCE_INF;
+
+  struct ChangedEdge
+  {
+    VertexId from;
+    VertexId to;
+    uint32_t oldWeight;
+    uint32_t newWeight;
+  };
+
+  std::vector<ChangedEdge> changes;
+  for (VertexId u = 0; u < m_nVertices; u++) {
+    for (size_t e = graph.edgesBegin(u); e != graph.edgesEnd(u); e++) {
+      if (graph.getEdgeWeight(e) != m_graph->getEdgeWeight(e)) {
+        changes.push_back({u, graph.getEdgeTarget(e), m_graph->getEdgeWeight(e),
+                           graph.getEdgeWeight(e)});
+      }
+    }
+  }
+
+  // The old distances stay valid if no changed edge was tight (increase) or is now
+  // shorter (decrease): they remain feasible, and the old shortest path trees remain intact.
+  std::vector<VertexId> rows;
+  for (VertexId s = 0; s < m_nVertices; s++) {
+    bool isAffected = std::any_of(changes.begin(), changes.end(), [&] (const ChangedEdge& c) {
+      uint32_t toFrom = get(s, c.from);
+      if (toFrom >= INF)
+        return false;
+      if (c.newWeight < c.oldWeight)
+        return toFrom + c.newWeight < get(s, c.to);
+      else
+        return toFrom + c.oldWeight == get(s, c.to);
+    });
+    if (isAffected) {
+      rows.push_back(s);
+    }
+  }
+
+  m_graph = &graph;
+  ParallelFor(rows.size(), nThreads, [this, &rows] (size_t i) {
+    computeRow(rows[i]);
+  });
+  return rows.size();
+}
+
+void
+DistanceMatrix::computeDistancesAvoiding(VertexId source, VertexId excluded,
+                                         std::vector<uint32_t>& distances) const
+{
+  const uint32_t INF = GlobalRoutingGraph::DISTANCE_INF;
+
+  distances.resize(m_nVertices);
+  std::vector<VertexId> affected;
+
+  // A vertex is affected if going through the excluded vertex is one of its shortest paths.
+  const GlobalRoutingGraph& graph = *m_graph;
+  const uint32_t toExcluded = get(source, excluded);
+  for (VertexId v = 0; v < m_nVertices; v++) {
+    uint32_t distance = get(source, v);
+    distances[v] = distance;
+    if (distance < INF && v != excluded && v != source
+        && distance == toExcluded + get(excluded, v)) {
+      affected.push_back(v);
+      distances[v] = INF;
+    }
+  }
+
+  if (affected.empty())
+    return;
+
+  // Seed affected vertices from their unaffected predecessors, then settle them with Dijkstra.
+  ShortestPathQueue<uint32_t, VertexId> queue;
+  for (VertexId v : affected) {
+    uint32_t best = INF;
+    for (size_t i = graph.inEdgesBegin(v); i != graph.inEdgesEnd(v); i++) {
+      VertexId u = graph.getInEdgeSource(i);
+      if (u == excluded)
+        continue;
+      best = std::min(best, distances[u] + graph.getEdgeWeight(graph.getInEdge(i)));
+    }
+    if (best < INF) {
+      distances[v] = best;
+      queue.push(best, v);
+    }
+  }
+
+  while (!queue.empty()) {
+    uint32_t distance = queue.top().first;
+    VertexId u = queue.top().second;
+    queue.pop();
+
+    if (distance != distances[u])
+      continue;
+
+    for (size_t e = graph.edgesBegin(u); e != graph.edgesEnd(u); e++) {
+      VertexId v = graph.getEdgeTarget(e);
+      uint32_t candidate = distance + graph.getEdgeWeight(e);
+      if (candidate < distances[v]) {
+        distances[v] = candidate;
+        queue.push(candidate, v);
+      }
+    }
+  }
+}
+
+DestinationTree::DestinationTree(const GlobalRoutingGraph& graph)
+  : m_graph(graph)
+  , m_avoided(GlobalRoutingGraph::INVALID_VERTEX)
+{
+}
+
+void
+DestinationTree::compute(VertexId dst)
+{
+  const auto INF = GlobalRoutingGraph::DISTANCE_INF;
+  const auto NONE = GlobalRoutingGraph::INVALID_VERTEX;
+  const size_t nVertices = m_graph.getNVertices();
+
+  m_avoided = NONE;
+  m_distances.assign(nVertices, INF);
+  m_parent.assign(nVertices, NONE);
+  m_distances[dst] = 0;
+  m_queue.clear();
+  m_queue.push(0, dst);
+
+  while (!m_queue.empty()) {
+    uint32_t distance = m_queue.top().first;
+    VertexId v = m_queue.top().second;
+    m_queue.pop();
+
+    if (distance != m_distances[v])
+      continue;
+
+    for (size_t i = m_graph.inEdgesBegin(v); i != m_graph.inEdgesEnd(v); i++) {
+      VertexId u = m_graph.getInEdgeSource(i);
+      uint32_t candidate = distance + m_graph.getEdgeWeight(m_graph.getInEdge(i));
+      if (candidate < m_distances[u]) {
+        m_distances[u] = candidate;
+        m_parent[u] = v;
+        m_queue.push(candidate, u);
+      }
+    }
+  }
+
+  // Children lists (CSR):
+  m_childBegin.assign(nVertices + 1, 0);
+  for (VertexId v = 0; v < nVertices; v++) {
+    if (m_parent[v] != NONE) {
+      m_childBegin[m_parent[v] + 1]++;
+    }
+  }
+  for (size_t v = 0; v < nVertices; v++) {
+    m_childBegin[v + 1] += m_childBegin[v];
+  }
+  m_children.resize(m_childBegin.back());
+  std::vector<uint32_t>& position = m_subtreeEnd; // reused as scratch
+  position.assign(m_childBegin.begin(), m_childBegin.end() - 1);
+  for (VertexId v = 0; v < nVertices; v++) {
+    if (m_parent[v] != NONE) {
+      m_children[position[m_parent[v]]++] = v;
+    }
+  }
+
+  // Preorder: the subtree of v is m_order[m_preorder[v], m_subtreeEnd[v]).
+  m_order.clear();
+  m_preorder.assign(nVertices, std::numeric_limits<uint32_t>::max());
+  m_subtreeEnd.assign(nVertices, 0);
+  m_stack.assign(1, dst);
+  while (!m_stack.empty()) {
+    VertexId v = m_stack.back();
+    if (m_preorder[v] == std::numeric_limits<uint32_t>::max()) {
+      m_preorder[v] = static_cast<uint32_t>(m_order.size());
+      m_order.push_back(v);
+      for (uint32_t c = m_childBegin[v]; c != m_childBegin[v + 1]; c++) {
+        m_stack.push_back(m_children[c]);
+      }
+    }
+    else {
+      m_subtreeEnd[v] = static_cast<uint32_t>(m_order.size());
+      m_stack.pop_back();
+    }
+  }
+}
+
+uint32_t
+DestinationTree::getDistanceAvoiding(VertexId v, VertexId excluded)
+{
+  if (!isInSubtree(v, excluded))
+    return m_distances[v];
+
+  if (excluded != m_avoided) {
+    computeAvoiding(excluded);
+    m_avoided = excluded;
+  }
+  return m_avoiding[v];
+}
+
+void
+DestinationTree::computeAvoiding(VertexId excluded)
+{
+  const auto INF = GlobalRoutingGraph::DISTANCE_INF;
+  m_avoiding.resize(m_graph.getNVertices());
+  m_avoiding[excluded] = INF;
+  m_queue.clear();
+
+  // Seed from the edges that leave the subtree:
+  for (uint32_t i = m_preorder[excluded] + 1; i < m_subtreeEnd[excluded]; i++) {
+    VertexId u = m_order[i];
+    uint32_t best = INF;
+    for (size_t e = m_graph.edgesBegin(u); e != m_graph.edgesEnd(u); e++) {
+      VertexId x = m_graph.getEdgeTarget(e);
+      if (!isInSubtree(x, excluded)) {
+        best = std::min(best, m_graph.getEdgeWeight(e) + m_distances[x]);
+      }
+    }
+    m_avoiding[u] = best;
+    if (best < INF) {
+      m_queue.push(best, u);
+    }
+  }
+
+  // Settle the subtree, never going through excluded:
+  while (!m_queue.empty()) {
+    uint32_t distance = m_queue.top().first;
+    VertexId v = m_queue.top().second;
+    m_queue.pop();
+
+    if (distance != m_avoiding[v])
+      continue;
+
+    for (size_t i = m_graph.inEdgesBegin(v); i != m_graph.inEdgesEnd(v); i++) {
+      VertexId u = m_graph.getInEdgeSource(i);
+      if (u == excluded || !isInSubtree(u, excluded))
+        continue;
+      uint32_t candidate = distance + m_graph.getEdgeWeight(m_graph.getInEdge(i));
+      if (candidate < m_avoiding[u]) {
+        m_avoiding[u] = candidate;
+        m_queue.push(candidate, u);
+      }
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
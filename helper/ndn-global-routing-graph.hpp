@@ -0,0 +1,447 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GLOBAL_ROUTING_GRAPH_H
+#define NDN_GLOBAL_ROUTING_GRAPH_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+
+#include "ns3/ptr.h"
+
+#include "ns3/ndnSIM/utils/radix-heap.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Immutable, index-based snapshot of the GlobalRouter graph
+ *
+ * Vertices are all GlobalRouters installed on nodes (in NodeList order), followed by
+ * GlobalRouters installed on multi-access channels (in ChannelList order).  Out-edges are
+ * stored in compressed sparse row form together with the edge weight (face metric) that was
+ * current when the snapshot was taken.
+ *
+ * The local prefixes of every vertex are copied into one shared list per vertex, which route
+ * calculations attach to the next hops towards the vertex (see FibHelper::RouteGroup).
+ *
+ * Once built, the snapshot does not reference any ns-3 object on the read path, so route
+ * computations on it can safely run on several threads at once.
+ */
+class GlobalRoutingGraph {
+public:
+  typedef uint32_t VertexId;
+
+  static constexpr VertexId INVALID_VERTEX = std::numeric_limits<VertexId>::max();
+
+  static constexpr uint32_t INVALID_EDGE = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Distances at or above this value denote an unreachable vertex
+   *
+   * Face metrics are 16 bit, and the value std::numeric_limits<uint16_t>::max() is reserved.
+   */
+  static constexpr uint32_t DISTANCE_INF = std::numeric_limits<uint16_t>::max();
+
+  /**
+   * @brief Shortest-path tree from one source, see computeShortestPaths()
+   *
+   * All vectors are indexed by VertexId.
+   */
+  struct ShortestPaths
+  {
+    /// @brief Distance from the source, DISTANCE_INF if unreachable
+    std::vector<uint32_t> distances;
+    /// @brief Previous vertex on the path, INVALID_VERTEX for the source and unreachable vertices
+    std::vector<VertexId> predecessors;
+    /// @brief Out-edge of the source the path starts with, INVALID_EDGE if there is none
+    std::vector<uint32_t> firstEdges;
+  };
+
+  /**
+   * @brief All equal-cost first hops from one source, see computeEqualCostFirstHops()
+   *
+   * The first hops of a vertex are stored as a bit set over the out-edges of the source: bit i
+   * of the @p nWords words starting at bits[v * nWords] stands for edge edgesBegin(source) + i.
+   */
+  struct EqualCostFirstHops
+  {
+    /// @brief Distance from the source, DISTANCE_INF if unreachable
+    std::vector<uint32_t> distances;
+    /// @brief Number of 64-bit words per vertex
+    size_t nWords = 0;
+    std::vector<uint64_t> bits;
+
+    /**
+     * @brief Call @p func with the index (relative to edgesBegin(source)) of every out-edge of
+     *        the source that starts a shortest path to @p v, in increasing order
+     */
+    template<class Function>
+    void
+    forEachFirstHop(VertexId v, const Function& func) const
+    {
+      for (size_t word = 0; word < nWords; word++) {
+        for (uint64_t mask = bits[v * nWords + word]; mask != 0; mask &= mask - 1) {
+          func(word * 64 + __builtin_ctzll(mask));
+        }
+      }
+    }
+  };
+
+  /**
+   * @brief Take a snapshot of all GlobalRouters and their incidencies
+   */
+  GlobalRoutingGraph();
+
+  size_t
+  getNVertices() const
+  {
+    return m_routers.size();
+  }
+
+  const Ptr<GlobalRouter>&
+  getRouter(VertexId v) const
+  {
+    return m_routers[v];
+  }
+
+  /**
+   * @brief Get local prefixes of the vertex (never nullptr, possibly empty)
+   */
+  const shared_ptr<const std::vector<Name>>&
+  getPrefixes(VertexId v) const
+  {
+    return m_prefixes[v];
+  }
+
+  /**
+   * @brief Get ns-3 node ID of the vertex, or -1 if the vertex represents a channel
+   */
+  int32_t
+  getNodeId(VertexId v) const
+  {
+    return m_nodeIds[v];
+  }
+
+  /**
+   * @brief Get vertex of the node with ID @p nodeId, or INVALID_VERTEX if it has no GlobalRouter
+   */
+  VertexId
+  getVertex(uint32_t nodeId) const
+  {
+    return nodeId < m_nodeVertices.size() ? m_nodeVertices[nodeId] : INVALID_VERTEX;
+  }
+
+  /// @brief Index of the first out-edge of @p v
+  size_t
+  edgesBegin(VertexId v) const
+  {
+    return m_edgeOffsets[v];
+  }
+
+  /// @brief Index past the last out-edge of @p v
+  size_t
+  edgesEnd(VertexId v) const
+  {
+    return m_edgeOffsets[v + 1];
+  }
+
+  VertexId
+  getEdgeTarget(size_t edge) const
+  {
+    return m_edgeTargets[edge];
+  }
+
+  uint32_t
+  getEdgeWeight(size_t edge) const
+  {
+    return m_edgeWeights[edge];
+  }
+
+  /// @brief Index of the first in-edge of @p v (see getInEdge())
+  size_t
+  inEdgesBegin(VertexId v) const
+  {
+    return m_inEdgeOffsets[v];
+  }
+
+  /// @brief Index past the last in-edge of @p v
+  size_t
+  inEdgesEnd(VertexId v) const
+  {
+    return m_inEdgeOffsets[v + 1];
+  }
+
+  /**
+   * @brief Get the out-edge index of the in-edge at position @p i
+   */
+  size_t
+  getInEdge(size_t i) const
+  {
+    return m_inEdges[i];
+  }
+
+  /**
+   * @brief Get source vertex of the in-edge at position @p i
+   */
+  VertexId
+  getInEdgeSource(size_t i) const
+  {
+    return m_inEdgeSources[i];
+  }
+
+  /**
+   * @brief Get face of the edge (nullptr for edges originating from a channel)
+   */
+  const shared_ptr<Face>&
+  getEdgeFace(size_t edge) const
+  {
+    return m_edgeFaces[edge];
+  }
+
+  /**
+   * @brief Compute shortest-path distances from @p source to all vertices
+   *
+   * @param source    source vertex
+   * @param distances output, indexed by VertexId; DISTANCE_INF marks unreachable vertices
+   * @param excluded  optional vertex whose out-edges are ignored, i.e., no path may traverse it
+   *                  (the vertex itself is still reachable)
+   */
+  void
+  computeDistances(VertexId source, std::vector<uint32_t>& distances,
+                   VertexId excluded = INVALID_VERTEX) const;
+
+  /**
+   * @brief Compute shortest-path distances and first-hop edges from @p source
+   *
+   * Runs on a RadixHeap.  Among several equal-cost paths, the first hop of any of them may be
+   * selected; use computeShortestPaths() where the selection has to be stable.
+   *
+   * @param source        source vertex
+   * @param distances     output, indexed by VertexId; DISTANCE_INF marks unreachable vertices
+   * @param firstEdges    output, indexed by VertexId: out-edge of @p source the path starts
+   *                      with, INVALID_EDGE for @p source and unreachable vertices
+   * @param sourceWeights optional weights of the out-edges of @p source, indexed by
+   *                      edge - edgesBegin(source), that replace the snapshot weights
+   */
+  void
+  computeFirstHops(VertexId source, std::vector<uint32_t>& distances,
+                   std::vector<uint32_t>& firstEdges,
+                   const std::vector<uint32_t>* sourceWeights = nullptr) const;
+
+  /**
+   * @brief Compute the shortest-path tree from @p source
+   *
+   * The search uses the same 4-ary heap and the same relaxation order as
+   * boost::dijkstra_shortest_paths, so among equal-cost paths the same one (and hence the same
+   * first-hop face) is selected as by the previous Boost Graph based route calculation.  It is
+   * slower than computeFirstHops().
+   *
+   * @param source        source vertex
+   * @param paths         output
+   * @param sourceWeights optional weights of the out-edges of @p source, indexed by
+   *                      edge - edgesBegin(source), that replace the snapshot weights
+   */
+  void
+  computeShortestPaths(VertexId source, ShortestPaths& paths,
+                       const std::vector<uint32_t>* sourceWeights = nullptr) const;
+
+  /**
+   * @brief Compute distances and the first hops of all shortest paths from @p source
+   *
+   * Unlike computeFirstHops(), which keeps one of several equal-cost paths, every out-edge of
+   * @p source that starts a shortest path to a vertex is kept.  This takes one Dijkstra run
+   * (on a RadixHeap) and one pass over the in-edges of the shortest-path DAG in distance
+   * order, in which a vertex unites the first hops of all its shortest-path predecessors.
+   */
+  void
+  computeEqualCostFirstHops(VertexId source, EqualCostFirstHops& firstHops) const;
+
+  /**
+   * @brief Check whether @p other has the same vertices and edges (faces), ignoring weights
+   */
+  bool
+  hasSameEdges(const GlobalRoutingGraph& other) const;
+
+private:
+  void
+  runDijkstra(VertexId source, std::vector<uint32_t>& distances, std::vector<uint32_t>* firstEdges,
+              VertexId excluded, const std::vector<uint32_t>* sourceWeights) const;
+
+private:
+  std::vector<Ptr<GlobalRouter>> m_routers;
+  std::vector<shared_ptr<const std::vector<Name>>> m_prefixes;
+  std::vector<int32_t> m_nodeIds;
+  std::vector<VertexId> m_nodeVertices;
+
+  std::vector<uint32_t> m_edgeOffsets;
+  std::vector<VertexId> m_edgeTargets;
+  std::vector<uint32_t> m_edgeWeights;
+  std::vector<shared_ptr<Face>> m_edgeFaces;
+
+  std::vector<uint32_t> m_inEdgeOffsets;
+  std::vector<uint32_t> m_inEdges;
+  std::vector<VertexId> m_inEdgeSources;
+};
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Dense all-pairs shortest-path distances on a GlobalRoutingGraph
+ *
+ * The table is filled with one Dijkstra run per vertex and stored row-major as uint16_t
+ * (face metrics are 16 bit and larger distances are unreachable anyway), i.e., it takes
+ * 2 * N^2 bytes.
+ */
+class DistanceMatrix {
+public:
+  typedef GlobalRoutingGraph::VertexId VertexId;
+
+  /**
+   * @brief Compute distances between all pairs of vertices of @p graph
+   * @param nThreads Number of threads for the Dijkstra runs (0: all hardware threads)
+   */
+  explicit
+  DistanceMatrix(const GlobalRoutingGraph& graph, uint32_t nThreads = 1);
+
+  /**
+   * @brief Get distance from @p from to @p to (GlobalRoutingGraph::DISTANCE_INF if unreachable)
+   */
+  uint32_t
+  get(VertexId from, VertexId to) const
+  {
+    return m_distances[static_cast<size_t>(from) * m_nVertices + to];
+  }
+
+  /**
+   * @brief Compute distances from @p source over paths that do not traverse @p excluded
+   *
+   * Same result as GlobalRoutingGraph::computeDistances(source, distances, excluded), but
+   * derived from the table: a vertex keeps its table distance unless one of its shortest
+   * paths may go through @p excluded.  Only those vertices are re-settled with Dijkstra.
+   */
+  void
+  computeDistancesAvoiding(VertexId source, VertexId excluded,
+                           std::vector<uint32_t>& distances) const;
+
+  /**
+   * @brief Update the table after edge weights changed
+   *
+   * @p graph must have the same edges as the graph the table was computed for, which must
+   * still be alive (see GlobalRoutingGraph::hasSameEdges).  A row is only recomputed if a
+   * changed edge was on one of its shortest paths (weight increase), or now shortens one of
+   * them (weight decrease).  Afterwards, the table refers to @p graph.
+   *
+   * @return Number of recomputed rows
+   */
+  size_t
+  update(const GlobalRoutingGraph& graph, uint32_t nThreads = 1);
+
+private:
+  void
+  computeRow(VertexId from);
+
+private:
+  const GlobalRoutingGraph* m_graph;
+  size_t m_nVertices;
+  std::vector<uint16_t> m_distances;
+};
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Distances of all vertices towards one destination, also over paths avoiding a vertex
+ *
+ * compute() runs a reverse Dijkstra from the destination, which gives the distances and a
+ * shortest-path tree.  The distance from v over paths that do not traverse a vertex x only
+ * differs if v is below x in the tree.  Those distances are re-settled within the subtree of x,
+ * starting from the edges that leave the subtree.  Thus, the detours around every vertex cost
+ * the sum of the subtree sizes (N * average tree depth) instead of N Dijkstra runs.
+ *
+ * Scratch space is kept for the next destination.  Instances are not thread-safe, use one
+ * per thread.
+ */
+class DestinationTree {
+public:
+  typedef GlobalRoutingGraph::VertexId VertexId;
+
+  explicit
+  DestinationTree(const GlobalRoutingGraph& graph);
+
+  /**
+   * @brief Compute distances and the shortest-path tree towards @p dst
+   */
+  void
+  compute(VertexId dst);
+
+  /**
+   * @brief Get distance from @p v to the destination (DISTANCE_INF if unreachable)
+   */
+  uint32_t
+  getDistance(VertexId v) const
+  {
+    return m_distances[v];
+  }
+
+  /**
+   * @brief Check whether the shortest path of @p v to the destination traverses @p root
+   */
+  bool
+  isInSubtree(VertexId v, VertexId root) const
+  {
+    return m_preorder[v] >= m_preorder[root] && m_preorder[v] < m_subtreeEnd[root];
+  }
+
+  /**
+   * @brief Get distance from @p v to the destination over paths that do not traverse
+   *        @p excluded (DISTANCE_INF if there is none)
+   *
+   * The detours for @p excluded are computed on first use, and kept until the next call with
+   * a different @p excluded vertex.
+   */
+  uint32_t
+  getDistanceAvoiding(VertexId v, VertexId excluded);
+
+private:
+  void
+  computeAvoiding(VertexId excluded);
+
+private:
+  const GlobalRoutingGraph& m_graph;
+
+  std::vector<uint32_t> m_distances;
+  std::vector<VertexId> m_parent;
+  std::vector<uint32_t> m_childBegin;
+  std::vector<VertexId> m_children;
+  std::vector<VertexId> m_order;
+  std::vector<uint32_t> m_preorder;
+  std::vector<uint32_t> m_subtreeEnd;
+  std::vector<VertexId> m_stack;
+
+  VertexId m_avoided;
+  std::vector<uint32_t> m_avoiding;
+  ShortestPathQueue<uint32_t, VertexId> m_queue;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GLOBAL_ROUTING_GRAPH_H
@@ -27,8 +27,11 @@
 
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-global-routing-graph.hpp"
+#include "helper/ndn-route-cache.hpp"
 #include "model/ndn-net-device-transport.hpp"
 #include "model/ndn-global-router.hpp"
+#include "utils/parallel-for.hpp"
 
 #include "daemon/table/fib.hpp"
 #include "daemon/fw/forwarder.hpp"
@@ -49,13 +52,13 @@
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
 #include <unordered_map>
 
-#include "boost-graph-ndn-global-routing-helper.hpp"
-
 #include <math.h>
 
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
@@ -63,6 +66,89 @@ NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 namespace ns3 {
 namespace ndn {
 
+uint32_t GlobalRoutingHelper::m_nThreads = 1;
+std::string GlobalRoutingHelper::m_routeCacheDirectory;
+uint64_t GlobalRoutingHelper::m_lfidMemoryBudget = 0;
+bool GlobalRoutingHelper::m_isLfidSplitWeights = false;
+double GlobalRoutingHelper::m_lfidSplitWeightExponent = 1;
+RoutingStatistics GlobalRoutingHelper::m_statistics;
+std::string GlobalRoutingHelper::m_statisticsFile;
+bool GlobalRoutingHelper::m_isVerbose = false;
+
+void
+GlobalRoutingHelper::SetNumThreads(uint32_t nThreads)
+{
+  m_nThreads = nThreads;
+}
+
+void
+GlobalRoutingHelper::SetRouteCacheDirectory(const std::string& directory)
+{
+  m_routeCacheDirectory = directory;
+}
+
+void
+GlobalRoutingHelper::SetLfidMemoryBudget(uint64_t bytes)
+{
+  m_lfidMemoryBudget = bytes;
+}
+
+void
+GlobalRoutingHelper::SetLfidSplitWeights(bool isEnabled, double exponent)
+{
+  m_isLfidSplitWeights = isEnabled;
+  m_lfidSplitWeightExponent = exponent;
+}
+
+const RoutingStatistics&
+GlobalRoutingHelper::GetStatistics()
+{
+  return m_statistics;
+}
+
+void
+GlobalRoutingHelper::SetStatisticsFile(const std::string& fileName)
+{
+  m_statisticsFile = fileName;
+}
+
+void
+GlobalRoutingHelper::SetVerbose(bool isVerbose)
+{
+  m_isVerbose = isVerbose;
+}
+
+void
+GlobalRoutingHelper::PublishStatistics(RoutingStatistics& statistics,
+                                       RoutingStatistics::Stopwatch& total)
+{
+  statistics.totalTime = total.lap();
+  m_statistics = statistics;
+
+  if (m_isVerbose) {
+    statistics.print(std::cout);
+  }
+
+  if (m_statisticsFile.empty())
+    return;
+
+  const bool isCsv = m_statisticsFile.size() >= 4
+    && m_statisticsFile.compare(m_statisticsFile.size() - 4, 4, ".csv") == 0;
+  std::ofstream os(m_statisticsFile, std::ios::app);
+  if (isCsv && os.tellp() == 0) {
+    RoutingStatistics::writeCsvHeader(os);
+  }
+  if (isCsv) {
+    statistics.writeCsv(os);
+  }
+  else {
+    statistics.writeJson(os);
+  }
+  if (!os) {
+    NS_LOG_WARN("Cannot write route calculation statistics to " << m_statisticsFile);
+  }
+}
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -217,173 +303,256 @@ GlobalRoutingHelper::AddOriginsForAll()
 void
 GlobalRoutingHelper::CalculateRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  RoutingStatistics statistics("shortest-path", 1);
+  RoutingStatistics::Stopwatch total;
+  RoutingStatistics::Stopwatch phase;
+
+  RouteCache cache(m_routeCacheDirectory, "shortest-path");
+  if (cache.install()) {
+    statistics.isCached = true;
+    statistics.installTime = phase.lap();
+    PublishStatistics(statistics, total);
+    return;
+  }
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  GlobalRoutingGraph graph;
+  GlobalRoutingGraph::ShortestPaths paths;
+  statistics.setTopology(graph);
+  statistics.snapshotTime = phase.lap();
 
   // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
+  for (GlobalRoutingGraph::VertexId source = 0; source < graph.getNVertices(); source++) {
+    if (graph.getNodeId(source) < 0)
+      continue; // channel
+
+    Ptr<Node> node = NodeList::GetNode(static_cast<uint32_t>(graph.getNodeId(source)));
+    graph.computeShortestPaths(source, paths);
+    statistics.spfTime += phase.lap();
+
+    NS_LOG_DEBUG("Reachability from Node: " << node->GetId());
+    std::vector<FibHelper::RouteGroup> routes;
+    for (GlobalRoutingGraph::VertexId v = 0; v < graph.getNVertices(); v++) {
+      const uint32_t edge = paths.firstEdges[v];
+      if (v == source || edge == GlobalRoutingGraph::INVALID_EDGE
+          || graph.getPrefixes(v)->empty())
+        continue; // unreachable or no origin
+
+      NS_LOG_DEBUG(" prefixes of vertex " << v << " reachable via face "
+                   << *graph.getEdgeFace(edge) << " with distance " << paths.distances[v]);
+      routes.push_back({graph.getPrefixes(v),
+                        {{graph.getEdgeFace(edge), static_cast<int32_t>(paths.distances[v])}}});
     }
+    statistics.fibFillTime += phase.lap();
 
-    boost::DistancesMap distances;
-
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
+    statistics.addRoutes(routes);
+    cache.add(node, routes);
+    FibHelper::AddRoutes(node, routes);
+    statistics.installTime += phase.lap();
+  }
 
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+  cache.save();
+  statistics.installTime += phase.lap();
+  PublishStatistics(statistics, total);
+}
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+void
+GlobalRoutingHelper::CalculateEcmpRoutes()
+{
+  RoutingStatistics statistics("ecmp", 1);
+  RoutingStatistics::Stopwatch total;
+  RoutingStatistics::Stopwatch phase;
+
+  RouteCache cache(m_routeCacheDirectory, "ecmp");
+  if (cache.install()) {
+    statistics.isCached = true;
+    statistics.installTime = phase.lap();
+    PublishStatistics(statistics, total);
+    return;
+  }
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
-        }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
-        }
-      }
+  GlobalRoutingGraph graph;
+  GlobalRoutingGraph::EqualCostFirstHops firstHops;
+  statistics.setTopology(graph);
+  statistics.snapshotTime = phase.lap();
+
+  for (GlobalRoutingGraph::VertexId source = 0; source < graph.getNVertices(); source++) {
+    if (graph.getNodeId(source) < 0)
+      continue; // channel
+
+    Ptr<Node> node = NodeList::GetNode(static_cast<uint32_t>(graph.getNodeId(source)));
+    graph.computeEqualCostFirstHops(source, firstHops);
+    statistics.spfTime += phase.lap();
+
+    NS_LOG_DEBUG("Reachability from Node: " << node->GetId());
+    std::vector<FibHelper::RouteGroup> routes;
+    for (GlobalRoutingGraph::VertexId v = 0; v < graph.getNVertices(); v++) {
+      if (v == source || graph.getPrefixes(v)->empty()
+          || firstHops.distances[v] >= GlobalRoutingGraph::DISTANCE_INF)
+        continue; // unreachable or no origin
+
+      const int32_t cost = static_cast<int32_t>(firstHops.distances[v]);
+      routes.push_back({graph.getPrefixes(v), {}});
+      firstHops.forEachFirstHop(v, [&] (size_t index) {
+        const shared_ptr<Face>& face = graph.getEdgeFace(graph.edgesBegin(source) + index);
+        NS_LOG_DEBUG(" prefixes of vertex " << v << " reachable via face " << *face
+                     << " with distance " << cost);
+        routes.back().nextHops.push_back({face, cost});
+      });
     }
+    statistics.fibFillTime += phase.lap();
+
+    statistics.addRoutes(routes);
+    cache.add(node, routes);
+    FibHelper::AddRoutes(node, routes);
+    statistics.installTime += phase.lap();
   }
+
+  cache.save();
+  statistics.installTime += phase.lap();
+  PublishStatistics(statistics, total);
 }
 
 void
 GlobalRoutingHelper::CalculateAllPossibleRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  typedef GlobalRoutingGraph::VertexId VertexId;
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
-
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
-    }
+  // Faces with this metric are disabled.
+  // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+  const uint32_t DISABLED_METRIC = std::numeric_limits<uint16_t>::max() - 1;
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+  RoutingStatistics statistics("all-possible", GetNumWorkerThreads(m_nThreads));
+  RoutingStatistics::Stopwatch total;
+  RoutingStatistics::Stopwatch phase;
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
+  RouteCache cache(m_routeCacheDirectory, "all-possible");
+  if (cache.install()) {
+    statistics.isCached = true;
+    statistics.installTime = phase.lap();
+    PublishStatistics(statistics, total);
+    return;
+  }
 
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
+  GlobalRoutingGraph graph;
+  statistics.setTopology(graph);
+  statistics.snapshotTime = phase.lap();
 
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& nfdFace : l3->getForwarder()->getFaceTable()) {
-      faceIds.push_back(nfdFace.getId());
-      originalMetrics[nfdFace.getId()] = nfdFace.getMetric();
-      nfdFace.setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+  std::vector<VertexId> origins;
+  for (VertexId v = 0; v < graph.getNVertices(); v++) {
+    if (!graph.getRouter(v)->GetLocalPrefixes().empty()) {
+      origins.push_back(v);
     }
+  }
 
-    for (auto& faceId : faceIds) {
-      auto* face = l3->getForwarder()->getFaceTable().get(faceId);
-      NS_ASSERT(face != nullptr);
-      auto transport = dynamic_cast<NetDeviceTransport*>(face->getTransport());
-      if (transport == nullptr) {
-        NS_LOG_DEBUG("Skipping non ndnSIM-specific transport face");
+  // The distance from a node to an origin when leaving through a face is the face metric plus
+  // the distance of the neighbor over paths that do not return to the node.  One tree per
+  // origin provides those for all nodes and faces (possibly in parallel).
+  struct Candidate
+  {
+    VertexId source;
+    VertexId origin;
+    uint32_t edge;
+    uint32_t distance;
+  };
+
+  std::vector<std::vector<Candidate>> candidates(origins.size());
+  std::vector<DestinationTree> trees(GetNumWorkerThreads(m_nThreads), DestinationTree(graph));
+  ParallelForWorkers(origins.size(), m_nThreads, [&] (uint32_t worker, size_t i) {
+    DestinationTree& tree = trees[worker];
+    const VertexId origin = origins[i];
+    tree.compute(origin);
+
+    for (VertexId source = 0; source < graph.getNVertices(); source++) {
+      if (source == origin || graph.getNodeId(source) < 0)
         continue;
-      }
-
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
-
-      boost::DistancesMap distances;
 
-      NS_LOG_DEBUG("-----------");
-
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
-
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-      for (const auto& dist : distances) {
-        if (dist.first == source)
+      for (size_t e = graph.edgesBegin(source); e != graph.edgesEnd(source); e++) {
+        if (graph.getEdgeWeight(e) == DISABLED_METRIC)
           continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
-            }
-          }
+
+        uint32_t distance = graph.getEdgeWeight(e)
+          + tree.getDistanceAvoiding(graph.getEdgeTarget(e), source);
+        if (distance < GlobalRoutingGraph::DISTANCE_INF) {
+          candidates[i].push_back({source, origin, static_cast<uint32_t>(e), distance});
         }
       }
+    }
+  });
+  statistics.spfTime = phase.lap();
+
+  // Route groups of each node by origin, each with the next hops in FaceTable order: counting
+  // sort of the candidates (ordered by origin) by their source, then sorting the candidates of
+  // each origin by the rank of their edge.
+  std::vector<uint32_t> edgeRanks(graph.getNVertices() == 0 ? 0 :
+                                  graph.edgesEnd(graph.getNVertices() - 1));
+  std::vector<uint32_t> edges;
+  for (VertexId source = 0; source < graph.getNVertices(); source++) {
+    edges.clear();
+    for (size_t e = graph.edgesBegin(source); e != graph.edgesEnd(source); e++) {
+      edges.push_back(static_cast<uint32_t>(e));
+    }
+    if (graph.getNodeId(source) >= 0) { // channel edges have no face
+      std::stable_sort(edges.begin(), edges.end(), [&graph] (uint32_t a, uint32_t b) {
+        return graph.getEdgeFace(a)->getId() < graph.getEdgeFace(b)->getId();
+      });
+    }
+    for (size_t i = 0; i < edges.size(); i++) {
+      edgeRanks[edges[i]] = static_cast<uint32_t>(i);
+    }
+  }
 
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
+  std::vector<size_t> offsets(graph.getNVertices() + 1, 0);
+  for (const auto& originCandidates : candidates) {
+    for (const auto& candidate : originCandidates) {
+      offsets[candidate.source + 1]++;
     }
+  }
+  for (size_t v = 0; v < graph.getNVertices(); v++) {
+    offsets[v + 1] += offsets[v];
+  }
+  std::vector<Candidate> all(offsets.back());
+  for (auto& originCandidates : candidates) {
+    for (const auto& candidate : originCandidates) {
+      all[offsets[candidate.source]++] = candidate;
+    }
+    std::vector<Candidate>().swap(originCandidates);
+  }
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
+  for (auto candidate = all.begin(); candidate != all.end();) {
+    const VertexId source = candidate->source;
+    Ptr<Node> node = NodeList::GetNode(static_cast<uint32_t>(graph.getNodeId(source)));
+    NS_LOG_DEBUG("Reachability from Node: " << node->GetId() << " ("
+                                            << Names::FindName(node) << ")");
+
+    std::vector<FibHelper::RouteGroup> routes;
+    while (candidate != all.end() && candidate->source == source) {
+      const VertexId origin = candidate->origin;
+      auto end = std::find_if(candidate, all.end(), [source, origin] (const Candidate& c) {
+        return c.source != source || c.origin != origin;
+      });
+      std::sort(candidate, end, [&edgeRanks] (const Candidate& a, const Candidate& b) {
+        return edgeRanks[a.edge] < edgeRanks[b.edge];
+      });
+
+      routes.push_back({graph.getPrefixes(origin), {}});
+      for (; candidate != end; candidate++) {
+        const shared_ptr<Face>& face = graph.getEdgeFace(candidate->edge);
+        NS_LOG_DEBUG(" prefixes of vertex " << origin << " reachable via face " << *face
+                     << " with distance " << candidate->distance);
+        routes.back().nextHops.push_back({face, static_cast<int32_t>(candidate->distance)});
+      }
     }
+    statistics.fibFillTime += phase.lap();
+
+    statistics.addRoutes(routes);
+    cache.add(node, routes);
+    FibHelper::AddRoutes(node, routes);
+    statistics.installTime += phase.lap();
   }
+
+  cache.save();
+  statistics.installTime += phase.lap();
+  PublishStatistics(statistics, total);
 }
 
 } // namespace ndn
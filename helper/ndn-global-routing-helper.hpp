@@ -21,6 +21,7 @@
 #define NDN_GLOBAL_ROUTING_HELPER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/helper/ndn-routing-statistics.hpp"
 
 #include "ns3/ptr.h"
 
@@ -100,29 +101,181 @@ public:
   static void
   CalculateRoutes();
 
+  /**
+   * @brief Calculate for every node shortest path DAGs and install routes to all prefix origins
+   *        over every equal-cost next hop
+   *
+   * Like CalculateRoutes(), it takes one Dijkstra run per node, but instead of a single
+   * shortest-path next hop, every face that starts a shortest path to the origin is installed,
+   * all with the same cost (the distance).
+   */
+  static void
+  CalculateEcmpRoutes();
 
   /**
    * @brief Calculates a set of loop-free multipath routes.
    *
    * TODO: Describe and link to tech report/paper.
+   *
+   * Abstract FIBs are only built towards nodes that originate at least one prefix, one
+   * destination at a time, so time and memory scale with the number of nodes times the number
+   * of origins rather than with the square of the number of nodes.
    */
   static void
   CalculateLFIDRoutes();
 
+  /**
+   * @brief Incrementally update LFID routes after link metric changes
+   *
+   * The first call calculates all routes like CalculateLFIDRoutes(), but keeps the distance
+   * table and abstract FIBs.  Each later call only recomputes distances from sources whose
+   * shortest paths are affected, re-runs loop and dead end removal only for destinations
+   * whose next hop candidates changed, and applies the difference (added, removed, and
+   * re-weighted next hops) to the FIBs of all nodes.  The difference is taken per FIB entry,
+   * over the next hops towards all origins of its prefix, so the result is the same as a full
+   * calculation on a fresh FIB, also for prefixes with several origins.
+   *
+   * Link changes are picked up through face metrics.  To fail a link for routing purposes,
+   * set the metric of its faces to std::numeric_limits<uint16_t>::max() (LinkControlHelper
+   * only drops packets).  If faces are added or removed, or prefix origins change, the next
+   * call starts over with a full calculation, which also removes the routes and split weights
+   * of the previous call that it does not install again.
+   */
+  static void
+  UpdateLFIDRoutes();
+
   /**
    * @brief Calculate all possible next-hop independent alternative routes
    *
-   * Refer to the implementation for more details.
+   * Every face of a node gets a route towards every prefix that is reachable through it
+   * without passing the node again, with the distance over that face as the cost.  Faces with
+   * metric std::numeric_limits<uint16_t>::max() - 1 are not used as next hops.  Face metrics
+   * are not modified.
    *
-   * Note that this method is highly experimental and should be used with caution (very time
-   *consuming).
+   * The distances are computed with one shortest-path tree per node with local prefixes, so
+   * the cost grows with the number of such nodes.  The trees can be computed on several
+   * threads, see SetNumThreads().
    */
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Set the number of worker threads used for route calculation
+   *
+   * Currently used by CalculateLFIDRoutes(), which then computes the abstract FIBs of
+   * different nodes concurrently, and removes loops and dead ends for different destinations
+   * concurrently, and by CalculateAllPossibleRoutes().  The result does not depend on the
+   * number of threads.
+   *
+   * @param nThreads Number of threads; 0 selects the number of hardware threads.
+   *                 Default is 1 (sequential calculation).
+   */
+  static void
+  SetNumThreads(uint32_t nThreads);
+
+  /**
+   * @brief Enable the on-disk route cache
+   *
+   * CalculateRoutes(), CalculateEcmpRoutes(), CalculateLFIDRoutes(), and
+   * CalculateAllPossibleRoutes() then look up
+   * a cache file for the current topology (GlobalRouter incidencies, face IDs and metrics,
+   * local prefixes) and the algorithm.  If one exists, its routes are installed without any
+   * calculation.  Otherwise, the calculated routes are saved for later runs.  This speeds up
+   * parameter sweeps that simulate the same topology many times.
+   *
+   * Nothing is ever removed from the directory.  The cache assumes that face IDs are assigned
+   * in the same order in every run, which holds if the scenario creates its topology
+   * deterministically.
+   *
+   * @param directory Cache directory (created if missing); empty disables the cache (default)
+   * @sa RouteCache
+   */
+  static void
+  SetRouteCacheDirectory(const std::string& directory);
+
+  /**
+   * @brief Limit the memory used by CalculateLFIDRoutes() for abstract FIBs
+   *
+   * Destinations are independent in LFID, so they are processed in batches: the abstract FIBs
+   * of a batch are calculated, cleaned of loops and dead ends, installed, and then discarded.
+   * The batch size is derived from an upper bound of the memory per destination (proportional
+   * to the number of links).  Origins of the same prefix are kept in one batch, which may
+   * then exceed the budget.  The result does not depend on the budget.
+   *
+   * @param bytes Memory budget; 0 processes all destinations at once (default)
+   */
+  static void
+  SetLfidMemoryBudget(uint64_t bytes);
+
+  /**
+   * @brief Also compute traffic split weights for the next hops installed by LFID
+   *
+   * Next hop i of an entry gets the weight d_i * (c_min / c_i)^exponent, normalized to a sum
+   * of 1.  Its cost c_i is the lowest cost c_min of the entry plus its cost delta, and d_i is
+   * the number of next hops of the neighbor towards the destination (the largest d_j of the
+   * entry for the destination itself).  Thus, short paths and neighbors with many onward
+   * paths get larger shares.  If a prefix has several origins, the entry covers the next hops
+   * towards all of them, and a next hop towards more than one origin gets its largest weight.
+   * The weights are stored in the SplitWeightTable of every node for weighted strategies.
+   *
+   * The route cache does not store weights, so it is not used while weights are enabled.
+   *
+   * @param isEnabled Default is false
+   * @param exponent Importance of the path stretch relative to the path diversity
+   */
+  static void
+  SetLfidSplitWeights(bool isEnabled, double exponent = 1);
+
+  /**
+   * @brief Get per-phase times and counters of the last route calculation
+   *
+   * Set by all Calculate*Routes() methods and UpdateLFIDRoutes().
+   */
+  static const RoutingStatistics&
+  GetStatistics();
+
+  /**
+   * @brief Append the statistics of every route calculation to a file
+   *
+   * Files whose name ends in ".csv" get one CSV row per calculation (and the column names if
+   * the file is empty); all other files get one JSON object per line.  The file is opened for
+   * each calculation, so it can be shared by sequential simulation runs.
+   *
+   * @param fileName File name; empty disables the export (default)
+   */
+  static void
+  SetStatisticsFile(const std::string& fileName);
+
+  /**
+   * @brief Print progress and statistics of route calculations to std::cout
+   * @param isVerbose Default is false
+   */
+  static void
+  SetVerbose(bool isVerbose);
+
 private:
   void
   Install(Ptr<Channel> channel);
+
+  static void
+  ResetLfidState();
+
+  /**
+   * @brief Finish @p statistics of a route calculation that started with @p total, make it
+   *        available through GetStatistics(), and export or print it
+   */
+  static void
+  PublishStatistics(RoutingStatistics& statistics, RoutingStatistics::Stopwatch& total);
+
+private:
+  static uint32_t m_nThreads;
+  static std::string m_routeCacheDirectory;
+  static uint64_t m_lfidMemoryBudget;
+  static bool m_isLfidSplitWeights;
+  static double m_lfidSplitWeightExponent;
+  static RoutingStatistics m_statistics;
+  static std::string m_statisticsFile;
+  static bool m_isVerbose;
 };
 
 } // namespace ndn
@@ -0,0 +1,406 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-route-cache.hpp"
+
+#include "model/ndn-global-router.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RouteCache");
+
+namespace ns3 {
+namespace ndn {
+
+struct RouteCache::Header
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t hash;
+  uint64_t nRecords;
+  uint32_t nVertices;
+  uint32_t nPrefixes;
+  uint32_t nGroups;
+  uint32_t nGroupPrefixes;
+};
+
+static const uint32_t CACHE_MAGIC = 0x52544e44; // "DNTR" on little-endian hosts
+static const uint32_t CACHE_VERSION = 2;
+
+namespace {
+
+/*
+ * 64-bit FNV-1a
+ */
+class Hasher
+{
+public:
+  void
+  add(const void* data, size_t size)
+  {
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      m_hash = (m_hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+  }
+
+  template<class T>
+  void
+  add(T value)
+  {
+    static_assert(std::is_integral<T>::value, "only integers are hashed by value");
+    uint64_t v = static_cast<uint64_t>(value);
+    add(&v, sizeof(v));
+  }
+
+  void
+  add(const std::string& str)
+  {
+    add(str.size());
+    add(str.data(), str.size());
+  }
+
+  uint64_t
+  get() const
+  {
+    return m_hash;
+  }
+
+private:
+  uint64_t m_hash = 0xcbf29ce484222325ULL;
+};
+
+/*
+ * Read-only memory mapping of a whole file
+ */
+class MappedFile : boost::noncopyable
+{
+public:
+  explicit
+  MappedFile(const std::string& fileName)
+  {
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        m_data = static_cast<const uint8_t*>(data);
+        m_size = static_cast<size_t>(st.st_size);
+      }
+    }
+    ::close(fd);
+  }
+
+  ~MappedFile()
+  {
+    if (m_data != nullptr) {
+      ::munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+  }
+
+  const uint8_t*
+  data() const
+  {
+    return m_data;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+private:
+  const uint8_t* m_data = nullptr;
+  size_t m_size = 0;
+};
+
+} // namespace
+
+RouteCache::RouteCache(const std::string& directory, const std::string& algorithm)
+  : m_directory(directory)
+  , m_algorithm(algorithm)
+  , m_hash(0)
+  , m_groupOffsets(1, 0)
+  , m_isComplete(true)
+{
+  if (!isEnabled())
+    return;
+
+  m_graph = make_unique<GlobalRoutingGraph>();
+  m_hash = computeHash(*m_graph, m_algorithm);
+
+  for (GlobalRoutingGraph::VertexId v = 0; v < m_graph->getNVertices(); v++) {
+    for (size_t e = m_graph->edgesBegin(v); e != m_graph->edgesEnd(v); e++) {
+      if (m_graph->getEdgeFace(e) != nullptr) {
+        m_edgeIndex.emplace(m_graph->getEdgeFace(e).get(), static_cast<uint32_t>(e));
+      }
+    }
+    for (const auto& prefix : m_graph->getRouter(v)->GetLocalPrefixes()) {
+      if (m_prefixIndex.emplace(*prefix, static_cast<uint32_t>(m_prefixes.size())).second) {
+        m_prefixes.push_back(*prefix);
+      }
+    }
+  }
+}
+
+uint64_t
+RouteCache::computeHash(const GlobalRoutingGraph& graph, const std::string& algorithm)
+{
+  Hasher hasher;
+  hasher.add(CACHE_VERSION);
+  hasher.add(algorithm);
+  hasher.add(graph.getNVertices());
+
+  for (GlobalRoutingGraph::VertexId v = 0; v < graph.getNVertices(); v++) {
+    hasher.add(graph.getNodeId(v));
+
+    hasher.add(graph.edgesEnd(v) - graph.edgesBegin(v));
+    for (size_t e = graph.edgesBegin(v); e != graph.edgesEnd(v); e++) {
+      const auto& face = graph.getEdgeFace(e);
+      hasher.add(graph.getEdgeTarget(e));
+      hasher.add(graph.getEdgeWeight(e));
+      hasher.add(face == nullptr ? uint64_t(0) : uint64_t(face->getId()));
+    }
+
+    const auto& prefixes = graph.getRouter(v)->GetLocalPrefixes();
+    hasher.add(prefixes.size());
+    for (const auto& prefix : prefixes) {
+      hasher.add(prefix->toUri());
+    }
+  }
+
+  return hasher.get();
+}
+
+std::string
+RouteCache::getFileName() const
+{
+  std::ostringstream os;
+  os << "routes-" << m_algorithm << "-" << std::hex << std::setw(16) << std::setfill('0')
+     << m_hash << ".bin";
+  return (boost::filesystem::path(m_directory) / os.str()).string();
+}
+
+bool
+RouteCache::install() const
+{
+  if (!isEnabled())
+    return false;
+
+  const std::string fileName = getFileName();
+  MappedFile file(fileName);
+  if (file.data() == nullptr) {
+    NS_LOG_INFO("No cached routes in " << fileName);
+    return false;
+  }
+
+  Header header;
+  if (file.size() < sizeof(header)) {
+    NS_LOG_WARN("Ignoring truncated route cache " << fileName);
+    return false;
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+
+  // The counts are bounded by the file size first, so that a corrupted header cannot make the
+  // sizes below wrap around:
+  const uint64_t maxEntries = file.size() / sizeof(uint32_t);
+  if (header.nGroups >= maxEntries || header.nGroupPrefixes >= maxEntries
+      || header.nRecords > file.size() / sizeof(Record)) {
+    NS_LOG_WARN("Ignoring corrupted route cache " << fileName);
+    return false;
+  }
+
+  const uint64_t groupsSize = (uint64_t(header.nGroups) + 1 + header.nGroupPrefixes)
+                              * sizeof(uint32_t);
+  if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.hash != m_hash
+      || header.nVertices != m_graph->getNVertices() || header.nPrefixes != m_prefixes.size()
+      || file.size() != sizeof(header) + groupsSize + header.nRecords * sizeof(Record)) {
+    NS_LOG_WARN("Ignoring invalid or outdated route cache " << fileName);
+    return false;
+  }
+
+  // Validate everything before installing anything:
+  const uint32_t* groupOffsets = reinterpret_cast<const uint32_t*>(file.data() + sizeof(header));
+  const uint32_t* groupPrefixes = groupOffsets + header.nGroups + 1;
+  bool isValid = groupOffsets[0] == 0 && groupOffsets[header.nGroups] == header.nGroupPrefixes;
+  for (uint32_t group = 0; isValid && group < header.nGroups; group++) {
+    isValid = groupOffsets[group] <= groupOffsets[group + 1];
+  }
+  for (uint32_t i = 0; isValid && i < header.nGroupPrefixes; i++) {
+    isValid = groupPrefixes[i] < m_prefixes.size();
+  }
+
+  const Record* records = reinterpret_cast<const Record*>(file.data() + sizeof(header)
+                                                          + groupsSize);
+  const Record* end = records + header.nRecords;
+  for (const Record* r = records; isValid && r != end; r++) {
+    isValid = r->vertex < m_graph->getNVertices() && m_graph->getNodeId(r->vertex) >= 0
+      && r->edge >= m_graph->edgesBegin(r->vertex) && r->edge < m_graph->edgesEnd(r->vertex)
+      && m_graph->getEdgeFace(r->edge) != nullptr && r->group < header.nGroups;
+  }
+  if (!isValid) {
+    NS_LOG_WARN("Ignoring corrupted route cache " << fileName);
+    return false;
+  }
+
+  std::vector<shared_ptr<const std::vector<Name>>> groups;
+  groups.reserve(header.nGroups);
+  for (uint32_t group = 0; group < header.nGroups; group++) {
+    auto prefixes = make_shared<std::vector<Name>>();
+    for (uint32_t i = groupOffsets[group]; i != groupOffsets[group + 1]; i++) {
+      prefixes->push_back(m_prefixes[groupPrefixes[i]]);
+    }
+    groups.push_back(std::move(prefixes));
+  }
+
+  // Records are grouped by node, and consecutive records of a node with the same prefix group
+  // form one RouteGroup:
+  std::vector<FibHelper::RouteGroup> routes;
+  for (const Record* r = records; r != end;) {
+    const uint32_t vertex = r->vertex;
+    routes.clear();
+    for (; r != end && r->vertex == vertex; r++) {
+      if (routes.empty() || routes.back().prefixes != groups[r->group]) {
+        routes.push_back({groups[r->group], {}});
+      }
+      routes.back().nextHops.push_back({m_graph->getEdgeFace(r->edge), r->metric});
+    }
+    FibHelper::AddRoutes(NodeList::GetNode(static_cast<uint32_t>(m_graph->getNodeId(vertex))),
+                         routes);
+  }
+
+  NS_LOG_INFO("Installed " << header.nRecords << " cached routes from " << fileName);
+  return true;
+}
+
+void
+RouteCache::add(Ptr<Node> node, const std::vector<FibHelper::RouteGroup>& groups)
+{
+  if (!isEnabled() || !m_isComplete)
+    return;
+
+  const auto vertex = m_graph->getVertex(node->GetId());
+  for (const auto& group : groups) {
+    if (group.nextHops.empty())
+      continue;
+
+    auto groupIndex = m_groupIndex.find(group.prefixes.get());
+    if (groupIndex == m_groupIndex.end()) {
+      for (const auto& name : *group.prefixes) {
+        auto prefix = m_prefixIndex.find(name);
+        if (prefix == m_prefixIndex.end()) {
+          NS_LOG_WARN("Route to " << name << " on node " << node->GetId()
+                      << " cannot be cached, routes will not be saved");
+          m_isComplete = false;
+          return;
+        }
+        m_groupPrefixes.push_back(prefix->second);
+      }
+      m_groupOffsets.push_back(static_cast<uint32_t>(m_groupPrefixes.size()));
+
+      groupIndex = m_groupIndex.emplace(group.prefixes.get(),
+                                        static_cast<uint32_t>(m_groups.size())).first;
+      m_groups.push_back(group.prefixes);
+    }
+
+    for (const auto& nextHop : group.nextHops) {
+      auto edge = m_edgeIndex.find(nextHop.face.get());
+      if (vertex == GlobalRoutingGraph::INVALID_VERTEX || edge == m_edgeIndex.end()
+          || edge->second < m_graph->edgesBegin(vertex)
+          || edge->second >= m_graph->edgesEnd(vertex)) {
+        NS_LOG_WARN("Route via face " << nextHop.face->getId() << " on node " << node->GetId()
+                    << " cannot be cached, routes will not be saved");
+        m_isComplete = false;
+        return;
+      }
+      m_records.push_back({vertex, edge->second, groupIndex->second, nextHop.metric});
+    }
+  }
+}
+
+bool
+RouteCache::save() const
+{
+  if (!isEnabled() || !m_isComplete)
+    return false;
+
+  // Records must be grouped by node; keep the installation order within each node:
+  std::vector<Record> records(m_records);
+  std::stable_sort(records.begin(), records.end(), [] (const Record& a, const Record& b) {
+    return a.vertex < b.vertex;
+  });
+
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = CACHE_MAGIC;
+  header.version = CACHE_VERSION;
+  header.hash = m_hash;
+  header.nRecords = records.size();
+  header.nVertices = static_cast<uint32_t>(m_graph->getNVertices());
+  header.nPrefixes = static_cast<uint32_t>(m_prefixes.size());
+  header.nGroups = static_cast<uint32_t>(m_groups.size());
+  header.nGroupPrefixes = static_cast<uint32_t>(m_groupPrefixes.size());
+
+  const std::string fileName = getFileName();
+  const std::string tmpFileName = fileName + ".tmp." + std::to_string(::getpid());
+
+  boost::system::error_code error;
+  boost::filesystem::create_directories(m_directory, error);
+
+  std::ofstream os(tmpFileName, std::ios::binary | std::ios::trunc);
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(m_groupOffsets.data()),
+           m_groupOffsets.size() * sizeof(uint32_t));
+  os.write(reinterpret_cast<const char*>(m_groupPrefixes.data()),
+           m_groupPrefixes.size() * sizeof(uint32_t));
+  os.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+  os.close();
+
+  if (!os || std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+    NS_LOG_WARN("Cannot write route cache " << fileName);
+    std::remove(tmpFileName.c_str());
+    return false;
+  }
+
+  NS_LOG_INFO("Saved " << records.size() << " routes to " << fileName);
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
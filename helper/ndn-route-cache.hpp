@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ROUTE_CACHE_H
+#define NDN_ROUTE_CACHE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
+
+#include "ns3/ptr.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief On-disk cache of the routes calculated by GlobalRoutingHelper
+ *
+ * The cache key is a hash of the GlobalRouter graph (vertices, incidencies, face IDs, face
+ * metrics, and local prefixes) and the name of the routing algorithm.  Each key is stored in
+ * its own file in the cache directory:
+ *
+ *     <directory>/routes-<algorithm>-<hash>.bin
+ *
+ * The file is a fixed-size header, a table of prefix groups (the prefix lists of the recorded
+ * FibHelper::RouteGroup instances), and one 16-byte record (node, edge, prefix group, metric)
+ * per next hop.  Faces and prefixes are stored as indices into the graph, so the file is read
+ * through a memory mapping and installed without any parsing.
+ *
+ * Usage in a route calculation:
+ *
+ *     RouteCache cache(directory, "lfid");
+ *     if (cache.install())
+ *       return;
+ *     // for each node: calculate route groups, call cache.add(node, groups), install them
+ *     cache.save();
+ *
+ * With an empty directory the cache is disabled, and all methods are no-ops.
+ */
+class RouteCache {
+public:
+  /**
+   * @brief Take a snapshot of the GlobalRouter graph and compute the cache key
+   * @param directory Directory of the cache files, empty to disable the cache
+   * @param algorithm Name of the routing algorithm, part of the key and the file name
+   */
+  RouteCache(const std::string& directory, const std::string& algorithm);
+
+  bool
+  isEnabled() const
+  {
+    return !m_directory.empty();
+  }
+
+  uint64_t
+  getHash() const
+  {
+    return m_hash;
+  }
+
+  /**
+   * @brief Get the path of the cache file for the current graph
+   */
+  std::string
+  getFileName() const;
+
+  /**
+   * @brief Install all cached routes using FibHelper::AddRoutes()
+   * @return false if the cache is disabled or there is no valid file for the current graph;
+   *         no route has been installed then
+   */
+  bool
+  install() const;
+
+  /**
+   * @brief Record routes installed on @p node, to be written by save()
+   *
+   * Groups are identified by their prefix list: groups that share the list are stored with
+   * one entry in the prefix group table.  Routes over a face that is not part of the graph,
+   * or to a prefix that no GlobalRouter originates, cannot be cached; save() then skips
+   * writing the file.
+   */
+  void
+  add(Ptr<Node> node, const std::vector<FibHelper::RouteGroup>& groups);
+
+  /**
+   * @brief Write all recorded routes to the cache file
+   *
+   * The file is written under a temporary name and then renamed, so concurrent simulations
+   * sharing the directory never read a partially written file.
+   *
+   * @return false if the cache is disabled or the file could not be written
+   */
+  bool
+  save() const;
+
+  /**
+   * @brief Compute the cache key of @p graph for @p algorithm
+   */
+  static uint64_t
+  computeHash(const GlobalRoutingGraph& graph, const std::string& algorithm);
+
+private:
+  struct Record
+  {
+    uint32_t vertex;
+    uint32_t edge;
+    uint32_t group;
+    int32_t metric;
+  };
+
+  struct Header;
+
+private:
+  std::string m_directory;
+  std::string m_algorithm;
+  std::unique_ptr<GlobalRoutingGraph> m_graph;
+  uint64_t m_hash;
+
+  std::vector<Name> m_prefixes;
+  std::map<Name, uint32_t> m_prefixIndex;
+  std::unordered_map<const Face*, uint32_t> m_edgeIndex;
+
+  // Recorded prefix lists (kept alive, so that their addresses identify them)
+  std::vector<shared_ptr<const std::vector<Name>>> m_groups;
+  std::unordered_map<const std::vector<Name>*, uint32_t> m_groupIndex;
+  // Prefix indices of each group, in CSR form
+  std::vector<uint32_t> m_groupOffsets;
+  std::vector<uint32_t> m_groupPrefixes;
+
+  std::vector<Record> m_records;
+  bool m_isComplete;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ROUTE_CACHE_H
@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-routing-statistics.hpp"
+
+#include <algorithm>
+#include <ostream>
+
+namespace ns3 {
+namespace ndn {
+
+constexpr double RoutingStatistics::STRETCH_BUCKET_WIDTH;
+constexpr size_t RoutingStatistics::N_STRETCH_BUCKETS;
+
+double
+RoutingStatistics::Stopwatch::lap()
+{
+  auto now = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(now - m_start).count();
+  m_start = now;
+  return seconds;
+}
+
+RoutingStatistics::RoutingStatistics(const std::string& algorithm, uint32_t nThreads)
+  : algorithm(algorithm)
+  , nThreads(nThreads)
+  , stretchHistogram(N_STRETCH_BUCKETS, 0)
+{
+}
+
+void
+RoutingStatistics::setTopology(const GlobalRoutingGraph& graph)
+{
+  nNodes = 0;
+  nDestinations = 0;
+  for (GlobalRoutingGraph::VertexId v = 0; v < graph.getNVertices(); v++) {
+    if (graph.getNodeId(v) >= 0) {
+      nNodes++;
+    }
+    if (!graph.getPrefixes(v)->empty()) {
+      nDestinations++;
+    }
+  }
+}
+
+void
+RoutingStatistics::addRoutes(const std::vector<FibHelper::RouteGroup>& groups)
+{
+  for (const auto& group : groups) {
+    if (group.nextHops.empty())
+      continue;
+
+    nEntries++;
+    nNextHops += group.nextHops.size();
+    if (nextHopsHistogram.size() <= group.nextHops.size()) {
+      nextHopsHistogram.resize(group.nextHops.size() + 1, 0);
+    }
+    nextHopsHistogram[group.nextHops.size()]++;
+
+    int32_t best = std::min_element(group.nextHops.begin(), group.nextHops.end(),
+                                    [] (const FibHelper::NextHop& a, const FibHelper::NextHop& b) {
+                                      return a.metric < b.metric;
+                                    })->metric;
+    if (best <= 0)
+      continue;
+
+    for (const auto& nextHop : group.nextHops) {
+      double stretch = static_cast<double>(nextHop.metric) / best;
+      // (the epsilon keeps exact multiples of the width out of the lower bucket)
+      size_t bucket = static_cast<size_t>((stretch - 1) / STRETCH_BUCKET_WIDTH + 1e-9);
+      stretchHistogram[std::min(bucket, N_STRETCH_BUCKETS - 1)]++;
+      stretchSum += stretch;
+      nStretches++;
+    }
+  }
+}
+
+double
+RoutingStatistics::getMeanNextHops() const
+{
+  return nEntries == 0 ? 0 : static_cast<double>(nNextHops) / nEntries;
+}
+
+double
+RoutingStatistics::getUpwardRatio() const
+{
+  return nNextHops == 0 ? 0 : static_cast<double>(nUpwardNextHops) / nNextHops;
+}
+
+double
+RoutingStatistics::getMeanStretch() const
+{
+  return nStretches == 0 ? 0 : stretchSum / nStretches;
+}
+
+static void
+writeList(std::ostream& os, const std::vector<uint64_t>& values, char separator)
+{
+  for (size_t i = 0; i < values.size(); i++) {
+    if (i > 0) {
+      os << separator;
+    }
+    os << values[i];
+  }
+}
+
+void
+RoutingStatistics::writeJson(std::ostream& os) const
+{
+  os << "{\"algorithm\":\"" << algorithm << "\""
+     << ",\"threads\":" << nThreads
+     << ",\"cached\":" << (isCached ? "true" : "false")
+     << ",\"nodes\":" << nNodes
+     << ",\"destinations\":" << nDestinations
+     << ",\"time\":{\"snapshot\":" << snapshotTime
+     << ",\"spf\":" << spfTime
+     << ",\"fibFill\":" << fibFillTime
+     << ",\"loopRemoval\":" << loopRemovalTime
+     << ",\"deadEndRemoval\":" << deadEndRemovalTime
+     << ",\"install\":" << installTime
+     << ",\"total\":" << totalTime << "}"
+     << ",\"entries\":" << nEntries
+     << ",\"nextHops\":" << nNextHops
+     << ",\"meanNextHops\":" << getMeanNextHops()
+     << ",\"upwardCandidates\":" << nUpwardCandidates
+     << ",\"upwardNextHops\":" << nUpwardNextHops
+     << ",\"upwardRatio\":" << getUpwardRatio()
+     << ",\"removedLoops\":" << nRemovedLoops
+     << ",\"removedDeadEnds\":" << nRemovedDeadEnds
+     << ",\"meanStretch\":" << getMeanStretch()
+     << ",\"nextHopsHistogram\":[";
+  writeList(os, nextHopsHistogram, ',');
+  os << "],\"stretchBucketWidth\":" << STRETCH_BUCKET_WIDTH
+     << ",\"stretchHistogram\":[";
+  writeList(os, stretchHistogram, ',');
+  os << "]}\n";
+}
+
+void
+RoutingStatistics::writeCsvHeader(std::ostream& os)
+{
+  os << "algorithm,threads,cached,nodes,destinations,"
+     << "snapshotTime,spfTime,fibFillTime,loopRemovalTime,deadEndRemovalTime,installTime,"
+     << "totalTime,entries,nextHops,meanNextHops,upwardCandidates,upwardNextHops,upwardRatio,"
+     << "removedLoops,removedDeadEnds,meanStretch,nextHopsHistogram,stretchHistogram\n";
+}
+
+void
+RoutingStatistics::writeCsv(std::ostream& os) const
+{
+  os << algorithm << "," << nThreads << "," << isCached << "," << nNodes << ","
+     << nDestinations << "," << snapshotTime << "," << spfTime << "," << fibFillTime << ","
+     << loopRemovalTime << "," << deadEndRemovalTime << "," << installTime << ","
+     << totalTime << "," << nEntries << "," << nNextHops << "," << getMeanNextHops() << ","
+     << nUpwardCandidates << "," << nUpwardNextHops << "," << getUpwardRatio() << ","
+     << nRemovedLoops << "," << nRemovedDeadEnds << "," << getMeanStretch() << ",";
+  writeList(os, nextHopsHistogram, ';');
+  os << ",";
+  writeList(os, stretchHistogram, ';');
+  os << "\n";
+}
+
+void
+RoutingStatistics::print(std::ostream& os) const
+{
+  os << "Route calculation " << algorithm << (isCached ? " (cached)" : "") << ": "
+     << nNodes << " nodes, " << nDestinations << " destinations, " << nThreads << " threads\n"
+     << "  time [s]: snapshot " << snapshotTime << ", SPF " << spfTime
+     << ", FIB fill " << fibFillTime << ", loop removal " << loopRemovalTime
+     << ", dead-end removal " << deadEndRemovalTime << ", install " << installTime
+     << ", total " << totalTime << "\n"
+     << "  " << nEntries << " entries, " << nNextHops << " next hops (" << getMeanNextHops()
+     << " per entry, mean stretch " << getMeanStretch() << ")\n";
+  if (nUpwardCandidates > 0) {
+    os << "  " << nUpwardCandidates << " upward candidates, removed " << nRemovedLoops
+       << " looping and " << nRemovedDeadEnds << " dead-end, installed " << nUpwardNextHops
+       << " (upward ratio " << getUpwardRatio() << ")\n";
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ROUTING_STATISTICS_H
+#define NDN_ROUTING_STATISTICS_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Timing and counters of one route calculation of GlobalRoutingHelper
+ *
+ * Phase times are wall-clock seconds; phases an algorithm does not have stay 0.  Counters
+ * refer to the installed routes: an entry is the set of next hops of one node towards one
+ * destination (prefix origin), independent of the number of prefixes of the destination.
+ * If the routes were installed from the route cache, only the times are set.
+ *
+ * @sa GlobalRoutingHelper::GetStatistics, GlobalRoutingHelper::SetStatisticsFile
+ */
+struct RoutingStatistics
+{
+  /**
+   * @brief Wall-clock stopwatch for phase times
+   */
+  class Stopwatch
+  {
+  public:
+    /**
+     * @brief Get seconds since construction or the previous lap(), and restart
+     */
+    double
+    lap();
+
+  private:
+    std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+  };
+
+  /// @brief Width of the buckets of stretchHistogram
+  static constexpr double STRETCH_BUCKET_WIDTH = 0.1;
+  /// @brief Number of buckets of stretchHistogram; the last one counts all larger stretches
+  static constexpr size_t N_STRETCH_BUCKETS = 41;
+
+  explicit
+  RoutingStatistics(const std::string& algorithm = "", uint32_t nThreads = 1);
+
+  /**
+   * @brief Set the number of nodes and destinations (vertices with local prefixes)
+   */
+  void
+  setTopology(const GlobalRoutingGraph& graph);
+
+  /**
+   * @brief Count the next hops of the entries installed on one node
+   */
+  void
+  addRoutes(const std::vector<FibHelper::RouteGroup>& groups);
+
+  /// @brief Mean number of next hops per entry
+  double
+  getMeanNextHops() const;
+
+  /// @brief Share of installed next hops that are upward (LFID only)
+  double
+  getUpwardRatio() const;
+
+  /// @brief Mean path stretch of all next hops, see stretchHistogram
+  double
+  getMeanStretch() const;
+
+  /**
+   * @brief Write the statistics as one JSON object (in one line)
+   */
+  void
+  writeJson(std::ostream& os) const;
+
+  /**
+   * @brief Write the column names for writeCsv()
+   */
+  static void
+  writeCsvHeader(std::ostream& os);
+
+  /**
+   * @brief Write the statistics as one CSV row; histograms are ';'-separated
+   */
+  void
+  writeCsv(std::ostream& os) const;
+
+  /**
+   * @brief Write the statistics in human-readable form
+   */
+  void
+  print(std::ostream& os) const;
+
+  /// @brief Name of the route calculation, as in the route cache file names
+  std::string algorithm;
+  uint32_t nThreads;
+  /// @brief Whether the routes were installed from the route cache
+  bool isCached = false;
+
+  uint64_t nNodes = 0;
+  uint64_t nDestinations = 0;
+
+  double snapshotTime = 0;
+  double spfTime = 0;
+  double fibFillTime = 0;
+  double loopRemovalTime = 0;
+  double deadEndRemovalTime = 0;
+  double installTime = 0;
+  double totalTime = 0;
+
+  uint64_t nEntries = 0;
+  uint64_t nNextHops = 0;
+  /// @brief Upward next hops before loop removal (LFID only)
+  uint64_t nUpwardCandidates = 0;
+  /// @brief Installed upward next hops (LFID only)
+  uint64_t nUpwardNextHops = 0;
+  uint64_t nRemovedLoops = 0;
+  uint64_t nRemovedDeadEnds = 0;
+
+  /// @brief Number of entries by their number of next hops (index)
+  std::vector<uint64_t> nextHopsHistogram;
+
+  /**
+   * @brief Number of next hops by path stretch
+   *
+   * The stretch of a next hop is its cost divided by the lowest cost of its entry.  Bucket i
+   * counts stretches in [1 + i * STRETCH_BUCKET_WIDTH, 1 + (i + 1) * STRETCH_BUCKET_WIDTH).
+   * Entries whose lowest cost is 0 are not included.
+   */
+  std::vector<uint64_t> stretchHistogram;
+  uint64_t nStretches = 0;
+  double stretchSum = 0;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ROUTING_STATISTICS_H
@@ -0,0 +1,349 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-traffic-engineering-helper.hpp"
+#include "ndn-global-routing-helper.hpp"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-net-device-transport.hpp"
+
+#include "ns3/channel.h"
+#include "ns3/data-rate.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TrafficEngineeringHelper");
+
+namespace ns3 {
+namespace ndn {
+
+// Metric of failed links (for routing purposes); the helper neither sets nor changes it
+const uint64_t FAILED_METRIC = std::numeric_limits<uint16_t>::max();
+
+// Largest metric set by the helper, below the values reserved by the route calculations
+const uint64_t MAX_METRIC = std::numeric_limits<uint16_t>::max() - 2;
+
+/**
+ * @brief Bytes sent over the faces of one node since the last take()
+ */
+class TrafficEngineeringHelper::FaceCounter : boost::noncopyable {
+public:
+  explicit
+  FaceCounter(Ptr<L3Protocol> l3)
+    : m_l3(l3)
+  {
+    m_l3->TraceConnectWithoutContext("OutInterests",
+                                     MakeCallback(&FaceCounter::OutInterests, this));
+    m_l3->TraceConnectWithoutContext("OutData",
+                                     MakeCallback(&FaceCounter::OutData, this));
+    m_l3->TraceConnectWithoutContext("OutNack",
+                                     MakeCallback(&FaceCounter::OutNack, this));
+  }
+
+  ~FaceCounter()
+  {
+    m_l3->TraceDisconnectWithoutContext("OutInterests",
+                                        MakeCallback(&FaceCounter::OutInterests, this));
+    m_l3->TraceDisconnectWithoutContext("OutData",
+                                        MakeCallback(&FaceCounter::OutData, this));
+    m_l3->TraceDisconnectWithoutContext("OutNack",
+                                        MakeCallback(&FaceCounter::OutNack, this));
+  }
+
+  Ptr<L3Protocol>
+  getL3Protocol() const
+  {
+    return m_l3;
+  }
+
+  /**
+   * @brief Start counting the bytes sent over @p face
+   */
+  void
+  add(nfd::FaceId face)
+  {
+    m_bytes.emplace(face, 0);
+  }
+
+  /**
+   * @brief Check whether the bytes sent over @p face are counted
+   */
+  bool
+  contains(nfd::FaceId face) const
+  {
+    return m_bytes.count(face) > 0;
+  }
+
+  /**
+   * @brief Get the bytes sent over @p face since the last call, and reset the counter
+   */
+  uint64_t
+  take(nfd::FaceId face)
+  {
+    auto it = m_bytes.find(face);
+    if (it == m_bytes.end())
+      return 0;
+
+    uint64_t bytes = it->second;
+    it->second = 0;
+    return bytes;
+  }
+
+private:
+  void
+  count(const Face& face, size_t bytes)
+  {
+    auto it = m_bytes.find(face.getId());
+    if (it != m_bytes.end()) {
+      it->second += bytes;
+    }
+  }
+
+  void
+  OutInterests(const Interest& interest, const Face& face)
+  {
+    count(face, interest.wireEncode().size());
+  }
+
+  void
+  OutData(const Data& data, const Face& face)
+  {
+    count(face, data.wireEncode().size());
+  }
+
+  void
+  OutNack(const lp::Nack& nack, const Face& face)
+  {
+    count(face, nack.getInterest().wireEncode().size());
+  }
+
+private:
+  Ptr<L3Protocol> m_l3;
+  // only faces of managed links; application faces are not counted
+  std::unordered_map<nfd::FaceId, uint64_t> m_bytes;
+};
+
+TrafficEngineeringHelper::TrafficEngineeringHelper()
+  : m_period(Seconds(1))
+  , m_damping(0.5)
+  , m_hysteresis(0.1)
+  , m_nUpdates(0)
+{
+}
+
+TrafficEngineeringHelper::~TrafficEngineeringHelper()
+{
+  m_optimizeEvent.Cancel();
+}
+
+void
+TrafficEngineeringHelper::SetPeriod(const Time& period)
+{
+  NS_ASSERT(period.IsStrictlyPositive());
+  m_period = period;
+}
+
+void
+TrafficEngineeringHelper::SetDamping(double damping)
+{
+  NS_ASSERT(damping >= 0 && damping < 1);
+  m_damping = damping;
+}
+
+void
+TrafficEngineeringHelper::SetHysteresis(double hysteresis)
+{
+  NS_ASSERT(hysteresis >= 0);
+  m_hysteresis = hysteresis;
+}
+
+void
+TrafficEngineeringHelper::Install(const NodeContainer& nodes)
+{
+  // 1. One counter per node, also across calls, so that no traffic is counted twice
+  size_t countersBegin = m_counters.size();
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
+    NS_ASSERT_MSG(l3 != nullptr, "NDN stack should be installed on the node " << (*node)->GetId());
+    if (m_counterOf.emplace((*node)->GetId(), m_counters.size()).second) {
+      m_counters.push_back(make_unique<FaceCounter>(l3));
+    }
+  }
+
+  // 2. Links of the new nodes to any counted node, unless already managed
+  for (size_t counter = countersBegin; counter < m_counters.size(); counter++) {
+    Ptr<L3Protocol> l3 = m_counters[counter]->getL3Protocol();
+    uint32_t nodeId = l3->GetObject<Node>()->GetId();
+    for (const auto& face : l3->getForwarder()->getFaceTable()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
+      if (transport == nullptr || m_counters[counter]->contains(face.getId()))
+        continue;
+
+      Ptr<NetDevice> device = transport->GetNetDevice();
+      Ptr<Channel> channel = device->GetChannel();
+      if (channel == nullptr || channel->GetNDevices() != 2)
+        continue;
+
+      Ptr<NetDevice> otherDevice = channel->GetDevice(channel->GetDevice(0) == device ? 1 : 0);
+      auto otherCounter = m_counterOf.find(otherDevice->GetNode()->GetId());
+      if (otherCounter == m_counterOf.end())
+        continue;
+
+      shared_ptr<Face> otherFace = m_counters[otherCounter->second]->getL3Protocol()
+                                     ->getFaceByNetDevice(otherDevice);
+      DataRateValue rate;
+      DataRateValue otherRate;
+      if (otherFace == nullptr || !device->GetAttributeFailSafe("DataRate", rate)
+          || !otherDevice->GetAttributeFailSafe("DataRate", otherRate)) {
+        NS_LOG_DEBUG("Skipping link of face " << face.getId() << " on node " << nodeId);
+        continue;
+      }
+
+      Link link;
+      link.faces[0] = l3->getFaceById(face.getId());
+      link.faces[1] = otherFace;
+      link.counters[0] = counter;
+      link.counters[1] = otherCounter->second;
+      link.capacities[0] = rate.Get().GetBitRate();
+      link.capacities[1] = otherRate.Get().GetBitRate();
+      link.baseMetric = std::max<uint64_t>(face.getMetric(), 1);
+      link.utilization = 0;
+      m_counters[link.counters[0]]->add(link.faces[0]->getId());
+      m_counters[link.counters[1]]->add(link.faces[1]->getId());
+      m_links.push_back(link);
+    }
+  }
+
+  NS_LOG_INFO("Managing " << m_links.size() << " links");
+  // keep the period of earlier calls, whose counters already run
+  if (!m_optimizeEvent.IsRunning()) {
+    m_lastOptimization = Simulator::Now();
+    m_optimizeEvent = Simulator::Schedule(m_period, &TrafficEngineeringHelper::PeriodicOptimize,
+                                          this);
+  }
+}
+
+void
+TrafficEngineeringHelper::InstallAll()
+{
+  Install(NodeContainer::GetGlobal());
+}
+
+void
+TrafficEngineeringHelper::PeriodicOptimize()
+{
+  Optimize();
+  m_optimizeEvent = Simulator::Schedule(m_period, &TrafficEngineeringHelper::PeriodicOptimize,
+                                        this);
+}
+
+double
+TrafficEngineeringHelper::GetPenalty(double utilization)
+{
+  // Slopes of the link cost function of Fortz and Thorup
+  if (utilization < 1.0 / 3)
+    return 1;
+  if (utilization < 2.0 / 3)
+    return 3;
+  if (utilization < 0.9)
+    return 10;
+  if (utilization < 1)
+    return 70;
+  if (utilization < 1.1)
+    return 500;
+  return 5000;
+}
+
+size_t
+TrafficEngineeringHelper::Optimize()
+{
+  double seconds = (Simulator::Now() - m_lastOptimization).GetSeconds();
+  if (seconds <= 0)
+    return 0;
+  m_lastOptimization = Simulator::Now();
+
+  size_t nChanged = 0;
+  for (Link& link : m_links) {
+    double utilization = 0;
+    for (int i = 0; i < 2; i++) {
+      uint64_t bytes = m_counters[link.counters[i]]->take(link.faces[i]->getId());
+      utilization = std::max(utilization, bytes * 8 / seconds / link.capacities[i]);
+    }
+    link.utilization = m_damping * link.utilization + (1 - m_damping) * utilization;
+
+    uint64_t metric = link.faces[0]->getMetric();
+    if (metric == FAILED_METRIC || link.faces[1]->getMetric() == FAILED_METRIC)
+      continue;
+
+    uint64_t newMetric = std::min<uint64_t>(std::llround(link.baseMetric
+                                                         * GetPenalty(link.utilization)),
+                                            MAX_METRIC);
+    if (newMetric == metric
+        || std::abs(static_cast<double>(newMetric) - metric) <= m_hysteresis * metric)
+      continue;
+
+    NS_LOG_INFO("Link " << link.faces[0]->getId() << "@" << link.counters[0] << " -- "
+                << link.faces[1]->getId() << "@" << link.counters[1] << ": utilization "
+                << link.utilization << ", metric " << metric << " -> " << newMetric);
+    link.faces[0]->setMetric(newMetric);
+    link.faces[1]->setMetric(newMetric);
+    nChanged++;
+  }
+
+  if (nChanged > 0) {
+    GlobalRoutingHelper::UpdateLFIDRoutes();
+    m_nUpdates++;
+  }
+  return nChanged;
+}
+
+const TrafficEngineeringHelper::Link*
+TrafficEngineeringHelper::FindLink(Ptr<Node> node1, Ptr<Node> node2) const
+{
+  for (const Link& link : m_links) {
+    Ptr<Node> linkNode1 = m_counters[link.counters[0]]->getL3Protocol()->GetObject<Node>();
+    Ptr<Node> linkNode2 = m_counters[link.counters[1]]->getL3Protocol()->GetObject<Node>();
+    if ((linkNode1 == node1 && linkNode2 == node2) || (linkNode1 == node2 && linkNode2 == node1))
+      return &link;
+  }
+  return nullptr;
+}
+
+double
+TrafficEngineeringHelper::GetUtilization(Ptr<Node> node1, Ptr<Node> node2) const
+{
+  const Link* link = FindLink(node1, node2);
+  return link == nullptr ? 0 : link->utilization;
+}
+
+size_t
+TrafficEngineeringHelper::GetNUpdates() const
+{
+  return m_nUpdates;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_TRAFFIC_ENGINEERING_HELPER_H
+#define NDN_TRAFFIC_ENGINEERING_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/event-id.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class L3Protocol;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Centralized traffic engineering controller that adapts link metrics to the load
+ *
+ * The helper counts the bytes of all Interests, Data and Nacks sent over the point-to-point
+ * faces of the installed nodes.  Every period, it computes the utilization of each link (the
+ * busier of its two directions, relative to the DataRate of the sending device), smooths it
+ * with an exponentially weighted moving average, and sets the metric of both faces of the
+ * link to
+ *
+ *     base metric * penalty(utilization)
+ *
+ * where the base metric is the face metric at installation time and the penalty is the slope
+ * of the piecewise linear link cost function of Fortz and Thorup: 1 below 1/3 utilization,
+ * then 3, 10 (above 2/3), 70 (above 90%), 500 (above 100%), and 5000 (above 110%).  To avoid
+ * route flapping, a metric only changes if it differs from the current one by more than the
+ * hysteresis.  If any metric changed, routes are updated with
+ * GlobalRoutingHelper::UpdateLFIDRoutes(), which only applies the resulting FIB changes.
+ *
+ * Links whose faces have the metric std::numeric_limits<uint16_t>::max() (failed for
+ * routing purposes) are left alone.  Apply the base metrics (e.g., with
+ * AnnotatedTopologyReader::ApplyOspfMetric()) and calculate the initial routes before
+ * installing the helper.  The helper has to stay alive for the whole simulation.
+ *
+ * Example:
+ *
+ *     ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+ *
+ *     ndn::TrafficEngineeringHelper te;
+ *     te.SetPeriod(Seconds(2));
+ *     te.InstallAll();
+ *
+ *     Simulator::Run();
+ */
+class TrafficEngineeringHelper : boost::noncopyable {
+public:
+  TrafficEngineeringHelper();
+
+  ~TrafficEngineeringHelper();
+
+  /**
+   * @brief Set how often link metrics are adjusted (default: 1 second)
+   *
+   * Has to be called before Install().
+   */
+  void
+  SetPeriod(const Time& period);
+
+  /**
+   * @brief Set the weight of the previous utilization estimate (default: 0.5)
+   *
+   * 0 uses the utilization of the last period only, values close to 1 react slowly.
+   */
+  void
+  SetDamping(double damping);
+
+  /**
+   * @brief Set the smallest relative metric change that is applied (default: 0.1)
+   */
+  void
+  SetHysteresis(double hysteresis);
+
+  /**
+   * @brief Count the traffic of @p nodes and periodically adjust the metrics of the links
+   *        between them
+   *
+   * Nodes need an NDN stack.  Only links with a DataRate attribute (e.g., point-to-point)
+   * are adjusted.  The first adjustment happens one period after the first call.
+   *
+   * Can be called several times: links between nodes of different calls are adjusted as
+   * well, and nodes or links that are already managed are ignored.
+   */
+  void
+  Install(const NodeContainer& nodes);
+
+  /**
+   * @brief Install on all nodes
+   */
+  void
+  InstallAll();
+
+  /**
+   * @brief Adjust the link metrics to the traffic since the last call, and update routes
+   *
+   * Called every period after Install(); can also be called manually.
+   *
+   * @returns number of links whose metric changed
+   */
+  size_t
+  Optimize();
+
+  /**
+   * @brief Get the smoothed utilization of the link between @p node1 and @p node2
+   * @returns utilization (may be above 1 if the link is overloaded), or 0 if the link is not
+   *          managed by the helper
+   */
+  double
+  GetUtilization(Ptr<Node> node1, Ptr<Node> node2) const;
+
+  /**
+   * @brief Get the number of route updates triggered so far
+   */
+  size_t
+  GetNUpdates() const;
+
+private:
+  class FaceCounter;
+
+  struct Link
+  {
+    shared_ptr<Face> faces[2];
+    /// @brief Counter of the node of faces[i]
+    size_t counters[2];
+    /// @brief DataRate of the device under faces[i] in bits per second
+    double capacities[2];
+    uint64_t baseMetric;
+    double utilization;
+  };
+
+  void
+  PeriodicOptimize();
+
+  const Link*
+  FindLink(Ptr<Node> node1, Ptr<Node> node2) const;
+
+  static double
+  GetPenalty(double utilization);
+
+private:
+  Time m_period;
+  double m_damping;
+  double m_hysteresis;
+
+  std::vector<unique_ptr<FaceCounter>> m_counters;
+  /// @brief Node ID -> index of its counter in m_counters
+  std::unordered_map<uint32_t, size_t> m_counterOf;
+  std::vector<Link> m_links;
+  Time m_lastOptimization;
+  EventId m_optimizeEvent;
+  size_t m_nUpdates;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_TRAFFIC_ENGINEERING_HELPER_H
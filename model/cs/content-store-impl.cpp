@@ -90,6 +90,23 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, FifoWithCountsTraits);
 template class ContentStoreImpl<LfuWithCountsTraits>;
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuWithCountsTraits);
 
+typedef ContentStoreImpl<lru_policy_traits, interned_key_traits> InternedLru;
+typedef ContentStoreImpl<random_policy_traits, interned_key_traits> InternedRandom;
+typedef ContentStoreImpl<fifo_policy_traits, interned_key_traits> InternedFifo;
+typedef ContentStoreImpl<lfu_policy_traits, interned_key_traits> InternedLfu;
+
+template class ContentStoreImpl<lru_policy_traits, interned_key_traits>;
+NS_OBJECT_ENSURE_REGISTERED(InternedLru);
+
+template class ContentStoreImpl<random_policy_traits, interned_key_traits>;
+NS_OBJECT_ENSURE_REGISTERED(InternedRandom);
+
+template class ContentStoreImpl<fifo_policy_traits, interned_key_traits>;
+NS_OBJECT_ENSURE_REGISTERED(InternedFifo);
+
+template class ContentStoreImpl<lfu_policy_traits, interned_key_traits>;
+NS_OBJECT_ENSURE_REGISTERED(InternedLfu);
+
 #ifdef DOXYGEN
 // /**
 //  * \brief Content Store implementing LRU cache replacement policy
@@ -114,6 +131,38 @@ class Random : public ContentStoreImpl<random_policy_traits> {
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> {
 };
+
+namespace Interned {
+
+/**
+ * \brief Content Store implementing LRU cache replacement policy, with the name components
+ *        shared with all other Interned content stores
+ */
+class Lru : public ContentStoreImpl<lru_policy_traits, interned_key_traits> {
+};
+
+/**
+ * \brief Content Store implementing FIFO cache replacement policy, with the name components
+ *        shared with all other Interned content stores
+ */
+class Fifo : public ContentStoreImpl<fifo_policy_traits, interned_key_traits> {
+};
+
+/**
+ * \brief Content Store implementing Random cache replacement policy, with the name components
+ *        shared with all other Interned content stores
+ */
+class Random : public ContentStoreImpl<random_policy_traits, interned_key_traits> {
+};
+
+/**
+ * \brief Content Store implementing Least Frequently Used cache replacement policy, with the
+ *        name components shared with all other Interned content stores
+ */
+class Lfu : public ContentStoreImpl<lfu_policy_traits, interned_key_traits> {
+};
+
+} // namespace Interned
 #endif
 
 } // namespace cs
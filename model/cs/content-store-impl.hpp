@@ -30,8 +30,10 @@
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
 #include "ns3/string.h"
+#include "ns3/traced-value.h"
 
 #include "../../utils/trie/trie-with-policy.hpp"
+#include "../../utils/trie/component-dictionary.hpp"
 
 namespace ns3 {
 namespace ndn {
@@ -74,25 +76,46 @@ private:
   typename CS::super::iterator item_;
 };
 
+} // namespace cs
+
+namespace ndnSIM {
+
+/**
+ * @brief Entries of content stores count with the wire size of their Data
+ */
+template<class CS>
+struct payload_bytes_traits<smart_pointer_payload_traits<cs::EntryImpl<CS>, cs::Entry>> {
+  static size_t
+  bytes(Ptr<const cs::EntryImpl<CS>> entry)
+  {
+    return entry->GetData()->wireEncode().size();
+  }
+};
+
+} // namespace ndnSIM
+
+namespace cs {
+
 /**
  * @ingroup ndn-cs
  * @brief Base implementation of NDN content store
  */
-template<class Policy>
+template<class Policy, class KeyTraits = ndnSIM::copy_key_traits<name::Component>>
 class ContentStoreImpl
   : public ContentStore,
     protected ndnSIM::
       trie_with_policy<Name,
-                       ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
-                                                            Entry>,
-                       Policy> {
+                       ndnSIM::smart_pointer_payload_traits<
+                         EntryImpl<ContentStoreImpl<Policy, KeyTraits>>, Entry>,
+                       Policy, KeyTraits> {
 public:
   typedef ndnSIM::
-    trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
-                                                                Entry>,
-                     Policy> super;
+    trie_with_policy<Name,
+                     ndnSIM::smart_pointer_payload_traits<
+                       EntryImpl<ContentStoreImpl<Policy, KeyTraits>>, Entry>,
+                     Policy, KeyTraits> super;
 
-  typedef EntryImpl<ContentStoreImpl<Policy>> entry;
+  typedef EntryImpl<ContentStoreImpl<Policy, KeyTraits>> entry;
 
   static TypeId
   GetTypeId();
@@ -117,6 +140,9 @@ public:
   virtual uint32_t
   GetSize() const;
 
+  virtual uint64_t
+  GetSizeBytes() const;
+
   virtual Ptr<Entry>
   Begin();
 
@@ -137,9 +163,22 @@ public:
     return super::getPolicy();
   }
 
+  const typename super::parent_trie&
+  GetTrie() const
+  {
+    return super::getTrie();
+  }
+
 public:
   typedef void (*CsEntryCallback)(Ptr<const Entry>);
 
+protected:
+  /**
+   * @brief Update the SizeBytes trace after entries have been added or removed
+   */
+  void
+  UpdateSizeBytes();
+
 private:
   void
   SetMaxSize(uint32_t maxSize);
@@ -147,40 +186,61 @@ private:
   uint32_t
   GetMaxSize() const;
 
+  void
+  SetMaxBytes(uint64_t maxBytes);
+
+  uint64_t
+  GetMaxBytes() const;
+
 private:
   static LogComponent g_log; ///< @brief Logging variable
 
   /// @brief trace of for entry additions (fired every time entry is successfully added to the
   /// cache): first parameter is pointer to the CS entry
   TracedCallback<Ptr<const Entry>> m_didAddEntry;
+
+  /// @brief total wire size of the cached Data packets
+  TracedValue<uint64_t> m_sizeBytes;
 };
 
 //////////////////////////////////////////
 ////////// Implementation ////////////////
 //////////////////////////////////////////
 
-template<class Policy>
-LogComponent ContentStoreImpl<Policy>::g_log = LogComponent(("ndn.cs." + Policy::GetName()).c_str(), __FILE__);
+template<class Policy, class KeyTraits>
+LogComponent ContentStoreImpl<Policy, KeyTraits>::g_log =
+  LogComponent(("ndn.cs." + KeyTraits::GetLogName() + Policy::GetName()).c_str(), __FILE__);
 
-template<class Policy>
+template<class Policy, class KeyTraits>
 TypeId
-ContentStoreImpl<Policy>::GetTypeId()
+ContentStoreImpl<Policy, KeyTraits>::GetTypeId()
 {
   static TypeId tid =
-    TypeId(("ns3::ndn::cs::" + Policy::GetName()).c_str())
+    TypeId(("ns3::ndn::cs::" + KeyTraits::GetName() + Policy::GetName()).c_str())
       .SetGroupName("Ndn")
       .SetParent<ContentStore>()
-      .AddConstructor<ContentStoreImpl<Policy>>()
+      .AddConstructor<ContentStoreImpl<Policy, KeyTraits>>()
       .AddAttribute("MaxSize",
                     "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
-                    StringValue("100"), MakeUintegerAccessor(&ContentStoreImpl<Policy>::GetMaxSize,
-                                                             &ContentStoreImpl<Policy>::SetMaxSize),
+                    StringValue("100"),
+                    MakeUintegerAccessor(&ContentStoreImpl<Policy, KeyTraits>::GetMaxSize,
+                                         &ContentStoreImpl<Policy, KeyTraits>::SetMaxSize),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("MaxBytes",
+                    "Set maximum total wire size of the Data packets in ContentStore, in bytes. "
+                    "If 0, limit is not enforced",
+                    StringValue("0"),
+                    MakeUintegerAccessor(&ContentStoreImpl<Policy, KeyTraits>::GetMaxBytes,
+                                         &ContentStoreImpl<Policy, KeyTraits>::SetMaxBytes),
+                    MakeUintegerChecker<uint64_t>())
 
       .AddTraceSource("DidAddEntry",
                       "Trace fired every time entry is successfully added to the cache",
-                      MakeTraceSourceAccessor(&ContentStoreImpl<Policy>::m_didAddEntry),
-                      "ns3::ndn::cs::ContentStoreImpl::CsEntryCallback");
+                      MakeTraceSourceAccessor(&ContentStoreImpl<Policy, KeyTraits>::m_didAddEntry),
+                      "ns3::ndn::cs::ContentStoreImpl::CsEntryCallback")
+      .AddTraceSource("SizeBytes", "Total wire size of the Data packets in the cache",
+                      MakeTraceSourceAccessor(&ContentStoreImpl<Policy, KeyTraits>::m_sizeBytes),
+                      "ns3::TracedValueCallback::Uint64");
 
   return tid;
 }
@@ -201,9 +261,9 @@ private:
   const Exclude& m_exclude;
 };
 
-template<class Policy>
+template<class Policy, class KeyTraits>
 shared_ptr<Data>
-ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
+ContentStoreImpl<Policy, KeyTraits>::Lookup(shared_ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION(this << interest->getName());
 
@@ -217,10 +277,11 @@ ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
   }
 
   if (node != this->end()) {
-    this->m_cacheHitsTrace(interest, node->payload()->GetData());
-
-    shared_ptr<Data> copy = make_shared<Data>(*node->payload()->GetData());
-    return copy;
+    shared_ptr<const Data> data = node->payload()->GetData();
+    this->m_cacheHitsTrace(interest, data);
+    // the entry's Data is handed out without a copy; callers must not modify it, apart from
+    // its tags (see ContentStore::Lookup)
+    return std::const_pointer_cast<Data>(data);
   }
   else {
     this->m_cacheMissesTrace(interest);
@@ -228,14 +289,15 @@ ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
   }
 }
 
-template<class Policy>
+template<class Policy, class KeyTraits>
 bool
-ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
+ContentStoreImpl<Policy, KeyTraits>::Add(shared_ptr<const Data> data)
 {
   NS_LOG_FUNCTION(this << data->getName());
 
   Ptr<entry> newEntry = Create<entry>(this, data);
   std::pair<typename super::iterator, bool> result = super::insert(data->getName(), newEntry);
+  UpdateSizeBytes(); // even a failed insert may have evicted entries
 
   if (result.first != super::end()) {
     if (result.second) {
@@ -254,9 +316,9 @@ ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
     return false; // cannot insert entry
 }
 
-template<class Policy>
+template<class Policy, class KeyTraits>
 void
-ContentStoreImpl<Policy>::Print(std::ostream& os) const
+ContentStoreImpl<Policy, KeyTraits>::Print(std::ostream& os) const
 {
   for (typename super::policy_container::const_iterator item = this->getPolicy().begin();
        item != this->getPolicy().end(); item++) {
@@ -264,30 +326,58 @@ ContentStoreImpl<Policy>::Print(std::ostream& os) const
   }
 }
 
-template<class Policy>
+template<class Policy, class KeyTraits>
 void
-ContentStoreImpl<Policy>::SetMaxSize(uint32_t maxSize)
+ContentStoreImpl<Policy, KeyTraits>::SetMaxSize(uint32_t maxSize)
 {
   this->getPolicy().set_max_size(maxSize);
 }
 
-template<class Policy>
+template<class Policy, class KeyTraits>
 uint32_t
-ContentStoreImpl<Policy>::GetMaxSize() const
+ContentStoreImpl<Policy, KeyTraits>::GetMaxSize() const
 {
   return this->getPolicy().get_max_size();
 }
 
-template<class Policy>
+template<class Policy, class KeyTraits>
+void
+ContentStoreImpl<Policy, KeyTraits>::SetMaxBytes(uint64_t maxBytes)
+{
+  this->getPolicy().set_max_bytes(maxBytes);
+}
+
+template<class Policy, class KeyTraits>
+uint64_t
+ContentStoreImpl<Policy, KeyTraits>::GetMaxBytes() const
+{
+  return this->getPolicy().get_max_bytes();
+}
+
+template<class Policy, class KeyTraits>
 uint32_t
-ContentStoreImpl<Policy>::GetSize() const
+ContentStoreImpl<Policy, KeyTraits>::GetSize() const
 {
   return this->getPolicy().size();
 }
 
-template<class Policy>
+template<class Policy, class KeyTraits>
+uint64_t
+ContentStoreImpl<Policy, KeyTraits>::GetSizeBytes() const
+{
+  return this->getPolicy().get_size_bytes();
+}
+
+template<class Policy, class KeyTraits>
+void
+ContentStoreImpl<Policy, KeyTraits>::UpdateSizeBytes()
+{
+  m_sizeBytes = GetSizeBytes();
+}
+
+template<class Policy, class KeyTraits>
 Ptr<Entry>
-ContentStoreImpl<Policy>::Begin()
+ContentStoreImpl<Policy, KeyTraits>::Begin()
 {
   typename super::parent_trie::recursive_iterator item(super::getTrie()), end(0);
   for (; item != end; item++) {
@@ -302,16 +392,16 @@ ContentStoreImpl<Policy>::Begin()
     return item->payload();
 }
 
-template<class Policy>
+template<class Policy, class KeyTraits>
 Ptr<Entry>
-ContentStoreImpl<Policy>::End()
+ContentStoreImpl<Policy, KeyTraits>::End()
 {
   return 0;
 }
 
-template<class Policy>
+template<class Policy, class KeyTraits>
 Ptr<Entry>
-ContentStoreImpl<Policy>::Next(Ptr<Entry> from)
+ContentStoreImpl<Policy, KeyTraits>::Next(Ptr<Entry> from)
 {
   if (from == 0)
     return 0;
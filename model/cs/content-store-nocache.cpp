@@ -73,6 +73,12 @@ Nocache::GetSize() const
   return 0;
 }
 
+uint64_t
+Nocache::GetSizeBytes() const
+{
+  return 0;
+}
+
 Ptr<cs::Entry>
 Nocache::Begin()
 {
@@ -64,6 +64,9 @@ public:
   virtual uint32_t
   GetSize() const;
 
+  virtual uint64_t
+  GetSizeBytes() const;
+
   virtual Ptr<cs::Entry>
   Begin();
 
@@ -93,6 +93,7 @@ struct freshness_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100)
+        , max_bytes_(0)
       {
       }
 
@@ -153,6 +154,24 @@ struct freshness_policy_traits {
         return max_size_;
       }
 
+      /**
+       * @brief Store the byte limit without enforcing it
+       *
+       * This policy only drops expired entries.  In ContentStoreWithFreshness, the other
+       * policy of the multi_policy (e.g., LRU) evicts entries to keep within the limit.
+       */
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
     private:
       type()
         : base_(*((Base*)0)){};
@@ -160,6 +179,7 @@ struct freshness_policy_traits {
     private:
       Base& base_;
       size_t max_size_;
+      size_t max_bytes_;
     };
   };
 };
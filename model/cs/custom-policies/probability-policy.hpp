@@ -64,6 +64,8 @@ struct probability_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100)
+        , max_bytes_(0)
+        , bytes_(0)
         , probability_(1.0)
         , ns3_rand_(CreateObject<UniformRandomVariable>())
       {
@@ -79,6 +81,7 @@ struct probability_policy_traits {
       {
         if (ns3_rand_->GetValue() < probability_) {
           policy_container::push_back(*item);
+          bytes_ += item->payload_bytes();
 
           // allow caching
           return true;
@@ -98,6 +101,7 @@ struct probability_policy_traits {
       inline void
       erase(typename parent_trie::iterator item)
       {
+        bytes_ -= item->payload_bytes();
         policy_container::erase(policy_container::s_iterator_to(*item));
       }
 
@@ -105,6 +109,7 @@ struct probability_policy_traits {
       clear()
       {
         policy_container::clear();
+        bytes_ = 0;
       }
 
       inline void
@@ -119,6 +124,30 @@ struct probability_policy_traits {
         return max_size_;
       }
 
+      /**
+       * @brief Store the byte limit without enforcing it
+       *
+       * This policy only decides about placement.  ContentStoreWithProbability pairs it with
+       * an evicting policy in multi_policy, and that policy keeps the store within the limit.
+       */
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
+      inline size_t
+      get_size_bytes() const
+      {
+        return bytes_;
+      }
+
       inline void
       set_probability(double probability)
       {
@@ -138,6 +167,8 @@ struct probability_policy_traits {
     private:
       Base& base_;
       size_t max_size_;
+      size_t max_bytes_;
+      size_t bytes_;
       double probability_;
       Ptr<UniformRandomVariable> ns3_rand_;
     };
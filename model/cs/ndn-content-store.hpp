@@ -116,9 +116,16 @@ public:
    * \brief Find corresponding CS entry for the given interest
    *
    * \param interest Interest for which matching content store entry will be searched
+   * \returns Data of the entry, shared with the content store (not a copy), or nullptr
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * The returned Data is the packet stored in the content store, not a copy: callers must not
+   * modify it (its name, content, signature, or fields such as FreshnessPeriod), as the change
+   * would show in every later hit.  Only tags may be set on it, as the forwarder does with the
+   * Data returned by NFD's Cs.  The pointer is not const only to keep the interface of the
+   * forwarder.
    */
   virtual shared_ptr<Data>
   Lookup(shared_ptr<const Interest> interest) = 0;
@@ -151,6 +158,12 @@ public:
   virtual uint32_t
   GetSize() const = 0;
 
+  /**
+   * @brief Get total wire size of the Data packets in content store, in bytes
+   */
+  virtual uint64_t
+  GetSizeBytes() const = 0;
+
   /**
    * @brief Return first element of content store (no order guaranteed)
    */
@@ -208,10 +221,10 @@ ContentStore::GetContentStore(Ptr<Object> node)
 #include <boost/functional/hash.hpp>
 namespace boost {
 inline std::size_t
-hash_value(const ::ndn::name::Component component)
+hash_value(const ::ndn::name::Component& component)
 {
-  return boost::hash_range(component.wireEncode().wire(),
-                           component.wireEncode().wire() + component.wireEncode().size());
+  const ::ndn::Block& wire = component.wireEncode();
+  return boost::hash_range(wire.wire(), wire.wire() + wire.size());
 }
 }
 
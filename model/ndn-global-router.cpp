@@ -70,6 +70,14 @@ GlobalRouter::AddLocalPrefix(shared_ptr<Name> prefix)
   m_localPrefixes.push_back(prefix);
 }
 
+void
+GlobalRouter::RemoveLocalPrefix(const Name& prefix)
+{
+  m_localPrefixes.remove_if([&prefix](const shared_ptr<Name>& localPrefix) {
+    return *localPrefix == prefix;
+  });
+}
+
 void
 GlobalRouter::AddIncidency(shared_ptr<Face> face, Ptr<GlobalRouter> gr)
 {
@@ -87,6 +87,13 @@ public:
   void
   AddLocalPrefix(shared_ptr<Name> prefix);
 
+  /**
+   * @brief Withdraw locally exported prefix (takes effect with the next route calculation)
+   * @param prefix Prefix
+   */
+  void
+  RemoveLocalPrefix(const Name& prefix);
+
   /**
    * @brief Add edge to the node
    * @param face Face of the edge
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-split-weight-table.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(SplitWeightTable);
+
+TypeId
+SplitWeightTable::GetTypeId()
+{
+  static TypeId tid = TypeId("ns3::ndn::SplitWeightTable")
+                        .SetGroupName("Ndn")
+                        .SetParent<Object>()
+                        .AddConstructor<SplitWeightTable>();
+  return tid;
+}
+
+Ptr<SplitWeightTable>
+SplitWeightTable::Get(Ptr<Node> node)
+{
+  Ptr<SplitWeightTable> table = node->GetObject<SplitWeightTable>();
+  if (table == nullptr) {
+    table = CreateObject<SplitWeightTable>();
+    node->AggregateObject(table);
+  }
+  return table;
+}
+
+void
+SplitWeightTable::set(const std::vector<Name>& prefixes, shared_ptr<const WeightList> weights)
+{
+  for (const Name& prefix : prefixes) {
+    m_weights[prefix] = weights;
+  }
+}
+
+void
+SplitWeightTable::erase(const Name& prefix)
+{
+  m_weights.erase(prefix);
+}
+
+shared_ptr<const SplitWeightTable::WeightList>
+SplitWeightTable::find(const Name& prefix) const
+{
+  auto it = m_weights.find(prefix);
+  return it == m_weights.end() ? nullptr : it->second;
+}
+
+double
+SplitWeightTable::getWeight(const Name& prefix, nfd::FaceId face) const
+{
+  auto weights = find(prefix);
+  if (weights == nullptr)
+    return 0;
+
+  for (const Weight& weight : *weights) {
+    if (weight.face == face)
+      return weight.weight;
+  }
+  return 0;
+}
+
+size_t
+SplitWeightTable::size() const
+{
+  return m_weights.size();
+}
+
+void
+SplitWeightTable::clear()
+{
+  m_weights.clear();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SPLIT_WEIGHT_TABLE_H
+#define NDN_SPLIT_WEIGHT_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Traffic split weights of the FIB next hops of a node
+ *
+ * Route calculations that compute split weights (see GlobalRoutingHelper::SetLfidSplitWeights)
+ * store them here, keyed by the prefix of the FIB entry.  The weights of an entry cover the
+ * next hops towards all origins of its prefix, and prefixes with the same origins share them.
+ * A weighted forwarding strategy reads them for the FIB entry it forwards along, e.g.:
+ *
+ *     auto table = ns3::NodeList::GetNode(ns3::Simulator::GetContext())
+ *                    ->GetObject<ns3::ndn::SplitWeightTable>();
+ *     double weight = table->getWeight(fibEntry.getPrefix(), nextHop.getFace().getId());
+ */
+class SplitWeightTable : public Object {
+public:
+  struct Weight
+  {
+    nfd::FaceId face;
+    /// @brief Share of the traffic; the weights of one entry add up to 1
+    double weight;
+  };
+
+  typedef std::vector<Weight> WeightList;
+
+  static TypeId
+  GetTypeId();
+
+  /**
+   * @brief Get the table of @p node, aggregating an empty one if there is none yet
+   */
+  static Ptr<SplitWeightTable>
+  Get(Ptr<Node> node);
+
+  /**
+   * @brief Set the weights of all @p prefixes
+   */
+  void
+  set(const std::vector<Name>& prefixes, shared_ptr<const WeightList> weights);
+
+  /**
+   * @brief Remove the weights of @p prefix
+   */
+  void
+  erase(const Name& prefix);
+
+  /**
+   * @brief Get the weights of the FIB entry with @p prefix
+   * @return nullptr if the entry has no weights
+   */
+  shared_ptr<const WeightList>
+  find(const Name& prefix) const;
+
+  /**
+   * @brief Get the weight of next hop @p face of the FIB entry with @p prefix
+   * @return 0 if there is no such weight
+   */
+  double
+  getWeight(const Name& prefix, nfd::FaceId face) const;
+
+  size_t
+  size() const;
+
+  void
+  clear();
+
+private:
+  std::map<Name, shared_ptr<const WeightList>> m_weights;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SPLIT_WEIGHT_TABLE_H
@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-cs-lookup-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/model/cs/content-store-impl.hpp"
+#include "ns3/ndnSIM/utils/trie/component-dictionary.hpp"
+#include "ns3/ndnSIM/utils/trie/fifo-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/lfu-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/lru-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/random-policy.hpp"
+
+#include <chrono>
+#include <random>
+
+namespace ns3 {
+
+/**
+ * Measures the cost of cache hits of the old-style content stores (ContentStoreImpl).  Lookup
+ * hands out the Data of the entry itself; for comparison, the benchmark also measures the
+ * same hits followed by the deep copy that Lookup used to make of every hit.  The memory used
+ * by the name trie of the content store is reported per entry.
+ *
+ *     ./waf --run "ndn-cs-lookup-benchmark --entries=10000 --lookups=1000000 --policy=Lru"
+ *
+ * With --depth, the cached names get additional components (with a fanout of 4) between the
+ * prefix and the sequence number.  With --caches, several content stores cache the same names
+ * and the lookups go to all of them in turn; compare, e.g., --policy=Lru with
+ * --policy=Interned::Lru.  The trie memory includes the dictionary of the interned components.
+ */
+class CsLookupBenchmark {
+public:
+  int
+  run(int argc, char* argv[]);
+
+private:
+  shared_ptr<Data>
+  makeData(const Name& name) const;
+
+  template<class Function>
+  double
+  measure(const std::string& name, const Function& func);
+
+  template<class Policy, class KeyTraits>
+  void
+  addTrieSize(Ptr<ndn::ContentStore> cs, size_t& nNodes, size_t& nBytes) const;
+
+  template<class KeyTraits>
+  void
+  addTrieSizes(Ptr<ndn::ContentStore> cs, size_t& nNodes, size_t& nBytes) const;
+
+private:
+  uint32_t m_nEntries = 10000;
+  uint32_t m_nCaches = 1;
+  uint32_t m_nLookups = 1000000;
+  uint32_t m_payloadSize = 1024;
+  uint32_t m_depth = 0;
+  uint32_t m_seed = 1;
+  uint32_t m_nRuns = 3;
+  std::string m_policy = "Lru";
+};
+
+shared_ptr<Data>
+CsLookupBenchmark::makeData(const Name& name) const
+{
+  // Same as the Data of ndn::Producer
+  auto data = make_shared<Data>(name);
+  data->setFreshnessPeriod(::ndn::time::seconds(1));
+  data->setContent(make_shared< ::ndn::Buffer>(m_payloadSize));
+
+  Signature signature;
+  signature.setInfo(SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)));
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+  data->setSignature(signature);
+  data->wireEncode();
+  return data;
+}
+
+template<class Function>
+double
+CsLookupBenchmark::measure(const std::string& name, const Function& func)
+{
+  double best = std::numeric_limits<double>::max();
+  for (uint32_t run = 0; run < m_nRuns; run++) {
+    auto begin = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(end - begin).count());
+  }
+  double perHit = best / m_nLookups * 1e9;
+  std::cout << name << "\t" << perHit << "ns/hit\n";
+  return perHit;
+}
+
+template<class Policy, class KeyTraits>
+void
+CsLookupBenchmark::addTrieSize(Ptr<ndn::ContentStore> cs, size_t& nNodes, size_t& nBytes) const
+{
+  auto impl = DynamicCast<ndn::cs::ContentStoreImpl<Policy, KeyTraits>>(cs);
+  if (impl != nullptr) {
+    nNodes += impl->GetTrie().node_count();
+    nBytes += impl->GetTrie().allocated_bytes();
+  }
+}
+
+template<class KeyTraits>
+void
+CsLookupBenchmark::addTrieSizes(Ptr<ndn::ContentStore> cs, size_t& nNodes, size_t& nBytes) const
+{
+  addTrieSize<ndn::ndnSIM::lru_policy_traits, KeyTraits>(cs, nNodes, nBytes);
+  addTrieSize<ndn::ndnSIM::fifo_policy_traits, KeyTraits>(cs, nNodes, nBytes);
+  addTrieSize<ndn::ndnSIM::lfu_policy_traits, KeyTraits>(cs, nNodes, nBytes);
+  addTrieSize<ndn::ndnSIM::random_policy_traits, KeyTraits>(cs, nNodes, nBytes);
+}
+
+int
+CsLookupBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("entries", "Number of entries in each content store", m_nEntries);
+  cmd.AddValue("caches", "Number of content stores with the same entries", m_nCaches);
+  cmd.AddValue("lookups", "Number of lookups per run", m_nLookups);
+  cmd.AddValue("payload", "Payload size of the Data packets in bytes", m_payloadSize);
+  cmd.AddValue("depth", "Number of name components between prefix and sequence number", m_depth);
+  cmd.AddValue("policy", "Replacement policy (Lru, Fifo, Lfu, Random, Interned::Lru, ...)",
+               m_policy);
+  cmd.AddValue("seed", "Seed of the requested names", m_seed);
+  cmd.AddValue("runs", "Number of runs per variant (the best one is reported)", m_nRuns);
+  cmd.Parse(argc, argv);
+
+  ObjectFactory factory("ns3::ndn::cs::" + m_policy);
+  factory.Set("MaxSize", UintegerValue(m_nEntries));
+  std::vector<Ptr<ndn::ContentStore>> caches;
+  for (uint32_t cache = 0; cache < m_nCaches; cache++) {
+    caches.push_back(factory.Create<ndn::ContentStore>());
+  }
+
+  std::vector<shared_ptr<const Interest>> interests;
+  interests.reserve(m_nEntries);
+  for (uint32_t i = 0; i < m_nEntries; i++) {
+    Name name("/benchmark/cs");
+    for (uint32_t level = 0; level < m_depth; level++) {
+      name.appendNumber((i >> (2 * level)) % 4);
+    }
+    name.appendSequenceNumber(i);
+    // every node decodes its own copy of a Data packet
+    for (const auto& cs : caches) {
+      cs->Add(makeData(name));
+    }
+    interests.push_back(make_shared<Interest>(name));
+  }
+
+  std::mt19937 random(m_seed);
+  std::uniform_int_distribution<uint32_t> entry(0, m_nEntries - 1);
+  std::vector<uint32_t> requests(m_nLookups);
+  for (auto& request : requests) {
+    request = entry(random);
+  }
+
+  size_t nBytes = 0;
+  double sharedTime = measure("Lookup", [&] {
+    for (uint32_t i = 0; i < m_nLookups; i++) {
+      const auto& cs = caches[i % m_nCaches];
+      shared_ptr<const Data> data = cs->Lookup(interests[requests[i]]);
+      nBytes += data->getContent().value_size();
+    }
+  });
+
+  double copyTime = measure("Lookup + copy", [&] {
+    for (uint32_t i = 0; i < m_nLookups; i++) {
+      const auto& cs = caches[i % m_nCaches];
+      shared_ptr<Data> data = make_shared<Data>(*cs->Lookup(interests[requests[i]]));
+      nBytes += data->getContent().value_size();
+    }
+  });
+
+  size_t nEntries = 0;
+  size_t nTrieNodes = 0;
+  size_t nTrieBytes = 0;
+  for (const auto& cs : caches) {
+    nEntries += cs->GetSize();
+    addTrieSizes<ndn::ndnSIM::copy_key_traits<ndn::name::Component>>(cs, nTrieNodes, nTrieBytes);
+    addTrieSizes<ndn::ndnSIM::interned_key_traits>(cs, nTrieNodes, nTrieBytes);
+  }
+  const auto& dictionary = ndn::ndnSIM::component_dictionary::global();
+  nTrieBytes += dictionary.allocated_bytes();
+
+  std::cout << "Entries\t" << nEntries << "\n"
+            << "Speedup of shared hits\t" << copyTime / sharedTime << "\n"
+            << "Checksum\t" << nBytes << "\n"
+            << "Trie nodes\t" << nTrieNodes << "\n"
+            << "Interned components\t" << dictionary.size() << "\n"
+            << "Trie bytes per entry\t" << static_cast<double>(nTrieBytes) / nEntries << "\n";
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::CsLookupBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,527 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-routing-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/utils/mem-usage.hpp"
+#include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
+
+#include <boost/algorithm/string.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+namespace ns3 {
+
+/**
+ * Measures the route calculations of GlobalRoutingHelper on one synthetic or Rocketfuel
+ * topology.  Every node (or --origins randomly chosen nodes) originates one prefix, and every
+ * algorithm listed in --algorithms computes and installs the routes towards all of them; the
+ * routes of the previous algorithm are removed first.
+ *
+ * Topologies (--nodes is approximate for grid and fat-tree):
+ *  - grid: square grid with random face metrics in [1, max-metric]
+ *  - geometric: random geometric graph in the unit square (mean degree --degree, metrics
+ *    proportional to the link length, components connected to the largest one)
+ *  - fat-tree: k-ary fat tree of switches (5k^2/4 nodes) with random face metrics
+ *  - rocketfuel: Rocketfuel map (.cch) given by --rocketfuel, OSPF metrics from bandwidths
+ *
+ * One JSON object (or CSV row) per algorithm is written to stdout or appended to --output.
+ * The peak resident set size is that of the process, so run one algorithm per process to
+ * attribute it (see ndn-routing-benchmark.sh).
+ *
+ *     ./waf --run "ndn-routing-benchmark --topology=grid --nodes=1000 --algorithms=lfid"
+ */
+class RoutingBenchmark {
+public:
+  int
+  run(int argc, char* argv[]);
+
+private:
+  struct Link
+  {
+    uint32_t from;
+    uint32_t to;
+    uint16_t metric;
+  };
+
+  struct Result
+  {
+    std::string algorithm;
+    double wallTime;
+    int64_t rss;
+    int64_t peakRss;
+    uint64_t nFibEntries;
+    uint64_t nNextHops;
+  };
+
+  uint16_t
+  randomMetric();
+
+  uint32_t
+  generateGrid(std::vector<Link>& links);
+
+  uint32_t
+  generateGeometric(std::vector<Link>& links);
+
+  uint32_t
+  generateFatTree(std::vector<Link>& links);
+
+  bool
+  buildTopology();
+
+  void
+  addOrigins();
+
+  void
+  removeRoutes();
+
+  void
+  countRoutes(uint64_t& nEntries, uint64_t& nNextHops);
+
+  bool
+  calculate(const std::string& algorithm, Result& result);
+
+  void
+  writeResult(std::ostream& os, const Result& result, bool isHeaderNeeded);
+
+private:
+  std::string m_topology = "grid";
+  uint32_t m_nNodes = 100;
+  double m_degree = 6;
+  std::string m_rocketfuelFile;
+  uint32_t m_maxMetric = 10;
+  uint32_t m_nOrigins = 0;
+  std::string m_algorithms = "routes,all-possible,lfid";
+  uint32_t m_nThreads = 1;
+  uint32_t m_seed = 1;
+  std::string m_format = "json";
+  std::string m_outputFile;
+
+  std::mt19937 m_random;
+  size_t m_nLinks = 0;
+  std::vector<std::pair<NetDeviceContainer, uint16_t>> m_devices;
+  unique_ptr<RocketfuelMapReader> m_rocketfuelReader;
+  size_t m_nPrefixes = 0;
+  const Name m_prefixRoot = "/benchmark";
+};
+
+uint16_t
+RoutingBenchmark::randomMetric()
+{
+  return std::uniform_int_distribution<uint16_t>(1, m_maxMetric)(m_random);
+}
+
+uint32_t
+RoutingBenchmark::generateGrid(std::vector<Link>& links)
+{
+  uint32_t size = std::max(2u, static_cast<uint32_t>(std::lround(std::sqrt(m_nNodes))));
+  for (uint32_t row = 0; row < size; row++) {
+    for (uint32_t column = 0; column < size; column++) {
+      uint32_t node = row * size + column;
+      if (column + 1 < size) {
+        links.push_back({node, node + 1, randomMetric()});
+      }
+      if (row + 1 < size) {
+        links.push_back({node, node + size, randomMetric()});
+      }
+    }
+  }
+  return size * size;
+}
+
+uint32_t
+RoutingBenchmark::generateGeometric(std::vector<Link>& links)
+{
+  const uint32_t n = std::max(2u, m_nNodes);
+  // mean degree = n * pi * radius^2
+  const double radius = std::min(1.0, std::sqrt(m_degree / (M_PI * n)));
+
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  std::vector<std::pair<double, double>> positions(n);
+  for (auto& position : positions) {
+    position.first = coordinate(m_random);
+    position.second = coordinate(m_random);
+  }
+  auto distance = [&] (uint32_t u, uint32_t v) {
+    return std::hypot(positions[u].first - positions[v].first,
+                      positions[u].second - positions[v].second);
+  };
+  auto metric = [&] (double length) {
+    return static_cast<uint16_t>(std::max(1.0, std::min<double>(m_maxMetric,
+                                                                std::ceil(length / radius
+                                                                          * m_maxMetric))));
+  };
+
+  // find the pairs closer than radius in the neighboring cells of a radius-wide grid
+  const uint32_t nCells = std::max(1u, static_cast<uint32_t>(1 / radius));
+  auto cellOf = [&] (double coordinate) {
+    return std::min(nCells - 1, static_cast<uint32_t>(coordinate * nCells));
+  };
+  std::vector<std::vector<uint32_t>> cells(nCells * nCells);
+  for (uint32_t u = 0; u < n; u++) {
+    cells[cellOf(positions[u].second) * nCells + cellOf(positions[u].first)].push_back(u);
+  }
+
+  std::vector<uint32_t> components(n);
+  std::iota(components.begin(), components.end(), 0);
+  std::function<uint32_t(uint32_t)> find = [&] (uint32_t u) {
+    return components[u] == u ? u : (components[u] = find(components[u]));
+  };
+
+  for (uint32_t u = 0; u < n; u++) {
+    int32_t x = cellOf(positions[u].first);
+    int32_t y = cellOf(positions[u].second);
+    for (int32_t cellY = std::max(0, y - 1); cellY <= std::min<int32_t>(nCells - 1, y + 1);
+         cellY++) {
+      for (int32_t cellX = std::max(0, x - 1); cellX <= std::min<int32_t>(nCells - 1, x + 1);
+           cellX++) {
+        for (uint32_t v : cells[cellY * nCells + cellX]) {
+          double length = distance(u, v);
+          if (u < v && length <= radius) {
+            links.push_back({u, v, metric(length)});
+            components[find(u)] = find(v);
+          }
+        }
+      }
+    }
+  }
+
+  // connect every other component with its nearest node of the largest component
+  std::vector<uint32_t> sizes(n, 0);
+  for (uint32_t u = 0; u < n; u++) {
+    sizes[find(u)]++;
+  }
+  uint32_t largest = std::max_element(sizes.begin(), sizes.end()) - sizes.begin();
+  std::vector<uint32_t> mainNodes;
+  for (uint32_t u = 0; u < n; u++) {
+    if (find(u) == largest) {
+      mainNodes.push_back(u);
+    }
+  }
+  std::vector<bool> isConnected(n, false);
+  for (uint32_t u = 0; u < n; u++) {
+    uint32_t component = find(u);
+    if (component == largest || isConnected[component])
+      continue;
+
+    uint32_t nearest = *std::min_element(mainNodes.begin(), mainNodes.end(),
+                                         [&] (uint32_t a, uint32_t b) {
+                                           return distance(u, a) < distance(u, b);
+                                         });
+    links.push_back({u, nearest, metric(distance(u, nearest))});
+    isConnected[component] = true;
+  }
+  return n;
+}
+
+uint32_t
+RoutingBenchmark::generateFatTree(std::vector<Link>& links)
+{
+  // smallest even k with 5k^2/4 switches: k pods of k/2 edge and k/2 aggregation switches,
+  // and (k/2)^2 core switches
+  uint32_t k = 2;
+  while (5 * k * k / 4 < m_nNodes) {
+    k += 2;
+  }
+  const uint32_t half = k / 2;
+  const uint32_t firstCore = k * k;
+
+  for (uint32_t pod = 0; pod < k; pod++) {
+    uint32_t firstEdge = pod * k;
+    uint32_t firstAggregation = firstEdge + half;
+    for (uint32_t aggregation = 0; aggregation < half; aggregation++) {
+      for (uint32_t edge = 0; edge < half; edge++) {
+        links.push_back({firstEdge + edge, firstAggregation + aggregation, randomMetric()});
+      }
+      for (uint32_t core = 0; core < half; core++) {
+        links.push_back({firstAggregation + aggregation, firstCore + aggregation * half + core,
+                         randomMetric()});
+      }
+    }
+  }
+  return firstCore + half * half;
+}
+
+bool
+RoutingBenchmark::buildTopology()
+{
+  if (m_topology == "rocketfuel") {
+    m_rocketfuelReader = make_unique<RocketfuelMapReader>("", 1.0);
+    m_rocketfuelReader->SetFileName(m_rocketfuelFile);
+
+    RocketfuelParams params;
+    params.averageRtt = 2.0;
+    params.clientNodeDegrees = 2;
+    params.minb2bBandwidth = "40Mbps";
+    params.minb2bDelay = "5ms";
+    params.maxb2bBandwidth = "400Mbps";
+    params.maxb2bDelay = "20ms";
+    params.minb2gBandwidth = "10Mbps";
+    params.minb2gDelay = "5ms";
+    params.maxb2gBandwidth = "40Mbps";
+    params.maxb2gDelay = "20ms";
+    params.ming2cBandwidth = "1Mbps";
+    params.ming2cDelay = "5ms";
+    params.maxg2cBandwidth = "10Mbps";
+    params.maxg2cDelay = "20ms";
+
+    if (m_rocketfuelReader->Read(params).GetN() == 0) {
+      std::cerr << "Cannot read Rocketfuel map '" << m_rocketfuelFile << "'\n";
+      return false;
+    }
+    m_nLinks = m_rocketfuelReader->GetLinks().size();
+    return true;
+  }
+
+  std::vector<Link> links;
+  uint32_t nNodes = 0;
+  if (m_topology == "grid") {
+    nNodes = generateGrid(links);
+  }
+  else if (m_topology == "geometric") {
+    nNodes = generateGeometric(links);
+  }
+  else if (m_topology == "fat-tree") {
+    nNodes = generateFatTree(links);
+  }
+  else {
+    std::cerr << "Unknown topology '" << m_topology << "'\n";
+    return false;
+  }
+
+  NodeContainer nodes;
+  nodes.Create(nNodes);
+  PointToPointHelper p2p;
+  for (const Link& link : links) {
+    m_devices.emplace_back(p2p.Install(nodes.Get(link.from), nodes.Get(link.to)), link.metric);
+  }
+  m_nLinks = links.size();
+  return true;
+}
+
+void
+RoutingBenchmark::addOrigins()
+{
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  std::vector<uint32_t> origins(NodeList::GetNNodes());
+  std::iota(origins.begin(), origins.end(), 0);
+  if (m_nOrigins > 0 && m_nOrigins < origins.size()) {
+    std::shuffle(origins.begin(), origins.end(), m_random);
+    origins.resize(m_nOrigins);
+  }
+  for (uint32_t node : origins) {
+    ndnGlobalRoutingHelper.AddOrigin(m_prefixRoot.toUri() + "/" + std::to_string(node),
+                                     NodeList::GetNode(node));
+  }
+  m_nPrefixes = origins.size();
+}
+
+void
+RoutingBenchmark::removeRoutes()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    auto& fib = (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+    std::vector<Name> prefixes;
+    for (const auto& entry : fib) {
+      if (m_prefixRoot.isPrefixOf(entry.getPrefix())) {
+        prefixes.push_back(entry.getPrefix());
+      }
+    }
+    for (const Name& prefix : prefixes) {
+      fib.erase(prefix);
+    }
+  }
+}
+
+void
+RoutingBenchmark::countRoutes(uint64_t& nEntries, uint64_t& nNextHops)
+{
+  nEntries = 0;
+  nNextHops = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    for (const auto& entry : (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFib()) {
+      if (m_prefixRoot.isPrefixOf(entry.getPrefix())) {
+        nEntries++;
+        nNextHops += entry.getNextHops().size();
+      }
+    }
+  }
+}
+
+bool
+RoutingBenchmark::calculate(const std::string& algorithm, Result& result)
+{
+  std::function<void()> calculateRoutes;
+  if (algorithm == "routes") {
+    calculateRoutes = &ndn::GlobalRoutingHelper::CalculateRoutes;
+  }
+  else if (algorithm == "ecmp") {
+    calculateRoutes = &ndn::GlobalRoutingHelper::CalculateEcmpRoutes;
+  }
+  else if (algorithm == "all-possible") {
+    calculateRoutes = &ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes;
+  }
+  else if (algorithm == "lfid") {
+    calculateRoutes = &ndn::GlobalRoutingHelper::CalculateLFIDRoutes;
+  }
+  else {
+    std::cerr << "Unknown algorithm '" << algorithm << "'\n";
+    return false;
+  }
+
+  removeRoutes();
+
+  auto begin = std::chrono::steady_clock::now();
+  calculateRoutes();
+  auto end = std::chrono::steady_clock::now();
+
+  result.algorithm = algorithm;
+  result.wallTime = std::chrono::duration<double>(end - begin).count();
+  result.rss = MemUsage::Get();
+  result.peakRss = MemUsage::GetPeak();
+  countRoutes(result.nFibEntries, result.nNextHops);
+  return true;
+}
+
+void
+RoutingBenchmark::writeResult(std::ostream& os, const Result& result, bool isHeaderNeeded)
+{
+  double routesPerSecond = result.wallTime > 0 ? result.nNextHops / result.wallTime : 0;
+
+  if (m_format == "csv") {
+    if (isHeaderNeeded) {
+      os << "topology,nodes,links,prefixes,algorithm,threads,wallTime,rss,peakRss,"
+         << "fibEntries,nextHops,routesPerSecond\n";
+    }
+    os << m_topology << "," << NodeList::GetNNodes() << "," << m_nLinks << "," << m_nPrefixes
+       << "," << result.algorithm << "," << m_nThreads << "," << result.wallTime << ","
+       << result.rss << "," << result.peakRss << "," << result.nFibEntries << ","
+       << result.nNextHops << "," << routesPerSecond << "\n";
+    return;
+  }
+
+  std::ostringstream statistics;
+  ndn::GlobalRoutingHelper::GetStatistics().writeJson(statistics);
+  os << "{\"topology\":\"" << m_topology << "\""
+     << ",\"nodes\":" << NodeList::GetNNodes()
+     << ",\"links\":" << m_nLinks
+     << ",\"prefixes\":" << m_nPrefixes
+     << ",\"algorithm\":\"" << result.algorithm << "\""
+     << ",\"threads\":" << m_nThreads
+     << ",\"wallTime\":" << result.wallTime
+     << ",\"rss\":" << result.rss
+     << ",\"peakRss\":" << result.peakRss
+     << ",\"fibEntries\":" << result.nFibEntries
+     << ",\"nextHops\":" << result.nNextHops
+     << ",\"routesPerSecond\":" << routesPerSecond
+     << ",\"statistics\":" << boost::trim_right_copy(statistics.str()) << "}\n";
+}
+
+int
+RoutingBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("topology", "grid, geometric, fat-tree or rocketfuel", m_topology);
+  cmd.AddValue("nodes", "Approximate number of nodes of synthetic topologies", m_nNodes);
+  cmd.AddValue("degree", "Mean node degree of the geometric topology", m_degree);
+  cmd.AddValue("rocketfuel", "Rocketfuel map file (.cch) of the rocketfuel topology",
+               m_rocketfuelFile);
+  cmd.AddValue("max-metric", "Face metrics of synthetic topologies are in [1, max-metric]",
+               m_maxMetric);
+  cmd.AddValue("origins", "Number of random prefix origins (0: all nodes)", m_nOrigins);
+  cmd.AddValue("algorithms", "Comma-separated list of routes, ecmp, all-possible and lfid",
+               m_algorithms);
+  cmd.AddValue("threads", "Number of threads of the route calculations", m_nThreads);
+  cmd.AddValue("seed", "Seed of the topology, metrics and origins", m_seed);
+  cmd.AddValue("format", "json or csv", m_format);
+  cmd.AddValue("output", "File to append the results to (default: stdout)", m_outputFile);
+  cmd.Parse(argc, argv);
+
+  m_random.seed(m_seed);
+  RngSeedManager::SetSeed(m_seed);
+
+  if (!buildTopology())
+    return 1;
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  if (m_rocketfuelReader != nullptr) {
+    m_rocketfuelReader->ApplyOspfMetric();
+  }
+  for (const auto& devices : m_devices) {
+    for (uint32_t i = 0; i < devices.first.GetN(); i++) {
+      Ptr<NetDevice> device = devices.first.Get(i);
+      device->GetNode()->GetObject<ndn::L3Protocol>()->getFaceByNetDevice(device)
+        ->setMetric(devices.second);
+    }
+  }
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  addOrigins();
+  ndn::GlobalRoutingHelper::SetNumThreads(m_nThreads);
+
+  std::ofstream file;
+  bool isHeaderNeeded = true;
+  if (!m_outputFile.empty()) {
+    file.open(m_outputFile, std::ios::app);
+    if (!file) {
+      std::cerr << "Cannot open '" << m_outputFile << "'\n";
+      return 1;
+    }
+    isHeaderNeeded = file.tellp() == 0;
+  }
+  std::ostream& os = m_outputFile.empty() ? std::cout : file;
+
+  std::vector<std::string> algorithms;
+  boost::split(algorithms, m_algorithms, boost::is_any_of(","));
+  for (const std::string& algorithm : algorithms) {
+    Result result;
+    if (!calculate(algorithm, result))
+      return 1;
+
+    writeResult(os, result, isHeaderNeeded);
+    os.flush();
+    isHeaderNeeded = false;
+  }
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::RoutingBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
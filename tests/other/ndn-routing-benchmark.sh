@@ -0,0 +1,33 @@
+#!/bin/bash
+
+# Runs ndn-routing-benchmark for every topology, size and algorithm in its own process (so that
+# the reported peak memory belongs to one route calculation) and appends the results as JSON
+# lines to routing-benchmark.json.
+#
+# A Rocketfuel map can be added with ROCKETFUEL=path/to/map.cch
+
+output=${OUTPUT:-routing-benchmark.json}
+threads=${THREADS:-1}
+sizes=${SIZES:-"10 100 1000 10000"}
+algorithms=${ALGORITHMS:-"routes all-possible lfid"}
+
+run() {
+  ../../../waf --run ndn-routing-benchmark \
+    --command-template="%s $* --threads=${threads} --output=${output}" || exit 1
+}
+
+for topology in grid geometric fat-tree; do
+  for nodes in $sizes; do
+    for algorithm in $algorithms; do
+      echo "Topology ${topology}, ${nodes} nodes, ${algorithm}.."
+      run --topology=${topology} --nodes=${nodes} --algorithms=${algorithm}
+    done
+  done
+done
+
+if [ -n "$ROCKETFUEL" ]; then
+  for algorithm in $algorithms; do
+    echo "Rocketfuel map ${ROCKETFUEL}, ${algorithm}.."
+    run --topology=rocketfuel --rocketfuel=${ROCKETFUEL} --algorithms=${algorithm}
+  done
+fi
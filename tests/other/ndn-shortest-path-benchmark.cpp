@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-shortest-path-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/helper/ndn-global-routing-graph.hpp"
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+
+#include <chrono>
+#include <numeric>
+#include <random>
+
+namespace ns3 {
+
+/**
+ * Compares the shortest-path kernels used by GlobalRoutingHelper with a plain
+ * boost::dijkstra_shortest_paths on an adjacency_list copy of the same graph.  Every kernel
+ * computes the distances from all nodes of a grid topology with random face metrics.
+ *
+ *     ./waf --run "ndn-shortest-path-benchmark --size=100 --max-metric=100"
+ */
+class ShortestPathBenchmark {
+public:
+  int
+  run(int argc, char* argv[]);
+
+private:
+  template<class Function>
+  double
+  measure(const std::string& name, const Function& func);
+
+private:
+  typedef ndn::GlobalRoutingGraph::VertexId VertexId;
+
+  uint32_t m_size = 50;
+  uint32_t m_maxMetric = 100;
+  uint32_t m_seed = 1;
+  uint32_t m_nRuns = 3;
+};
+
+template<class Function>
+double
+ShortestPathBenchmark::measure(const std::string& name, const Function& func)
+{
+  double best = std::numeric_limits<double>::max();
+  for (uint32_t run = 0; run < m_nRuns; run++) {
+    auto begin = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double>(end - begin).count());
+  }
+  std::cout << name << "\t" << best << "s\n";
+  return best;
+}
+
+int
+ShortestPathBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("size", "Number of rows and columns of the grid", m_size);
+  cmd.AddValue("max-metric", "Face metrics are drawn from [1, max-metric]", m_maxMetric);
+  cmd.AddValue("seed", "Seed of the face metrics", m_seed);
+  cmd.AddValue("runs", "Number of runs per kernel (the best one is reported)", m_nRuns);
+  cmd.Parse(argc, argv);
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(m_size, m_size, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  std::mt19937 random(m_seed);
+  std::uniform_int_distribution<uint32_t> metric(1, m_maxMetric);
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    for (auto& face : (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFaceTable()) {
+      face.setMetric(metric(random));
+    }
+  }
+
+  ndn::GlobalRoutingGraph graph;
+  const size_t nVertices = graph.getNVertices();
+  std::cout << "Vertices\t" << nVertices << "\n"
+            << "Edges\t" << graph.edgesEnd(nVertices - 1) << "\n";
+
+  typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::no_property,
+                                boost::property<boost::edge_weight_t, uint32_t>> BoostGraph;
+  BoostGraph boostGraph(nVertices);
+  for (VertexId u = 0; u < nVertices; u++) {
+    for (size_t e = graph.edgesBegin(u); e != graph.edgesEnd(u); e++) {
+      boost::add_edge(u, graph.getEdgeTarget(e), graph.getEdgeWeight(e), boostGraph);
+    }
+  }
+
+  std::vector<uint64_t> checksums(3, 0);
+  std::vector<uint32_t> distances;
+  std::vector<uint32_t> firstEdges;
+  std::vector<VertexId> predecessors(nVertices);
+  ndn::GlobalRoutingGraph::ShortestPaths paths;
+
+  double boostTime = measure("boost::dijkstra_shortest_paths", [&] {
+    checksums[0] = 0;
+    for (VertexId source = 0; source < nVertices; source++) {
+      distances.assign(nVertices, 0);
+      boost::dijkstra_shortest_paths(boostGraph, source,
+                                     boost::distance_map(distances.data())
+                                       .predecessor_map(predecessors.data()));
+      checksums[0] += std::accumulate(distances.begin(), distances.end(), uint64_t(0));
+    }
+  });
+
+  double heapTime = measure("computeShortestPaths (4-ary heap)", [&] {
+    checksums[1] = 0;
+    for (VertexId source = 0; source < nVertices; source++) {
+      graph.computeShortestPaths(source, paths);
+      checksums[1] += std::accumulate(paths.distances.begin(), paths.distances.end(),
+                                      uint64_t(0));
+    }
+  });
+
+  double radixTime = measure("computeFirstHops (radix heap)", [&] {
+    checksums[2] = 0;
+    for (VertexId source = 0; source < nVertices; source++) {
+      graph.computeFirstHops(source, distances, firstEdges);
+      checksums[2] += std::accumulate(distances.begin(), distances.end(), uint64_t(0));
+    }
+  });
+
+  std::cout << "Speedup of the 4-ary heap over Boost\t" << boostTime / heapTime << "\n"
+            << "Speedup of the radix heap over Boost\t" << boostTime / radixTime << "\n";
+
+  if (checksums[0] != checksums[1] || checksums[0] != checksums[2]) {
+    std::cerr << "Kernels computed different distances\n";
+    return 1;
+  }
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::ShortestPathBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -18,9 +18,15 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "daemon/fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
+#include <set>
+#include <tuple>
+
 namespace ns3 {
 namespace ndn {
 
@@ -56,6 +62,32 @@ public:
     BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nInInterests, 10);
     BOOST_CHECK_EQUAL(getFace("2", "1")->getCounters().nOutData, 10);
   }
+
+  using NextHops = std::set<std::tuple<nfd::FaceId, uint64_t>>;
+
+  /**
+   * @brief Get (face ID, cost) of all next hops for @p prefix on @p node
+   */
+  NextHops
+  getNextHops(const std::string& node, const Name& prefix)
+  {
+    NextHops nextHops;
+    const auto* entry = getNode(node)->GetObject<L3Protocol>()->getForwarder()->getFib()
+                          .findExactMatch(prefix);
+    if (entry != nullptr) {
+      for (const auto& nextHop : entry->getNextHops()) {
+        nextHops.emplace(nextHop.getFace().getId(), nextHop.getCost());
+      }
+    }
+    return nextHops;
+  }
+
+  void
+  processCommands()
+  {
+    Simulator::Stop(Seconds(0.001));
+    Simulator::Run();
+  }
 };
 
 BOOST_FIXTURE_TEST_SUITE(AddRoute, AddRouteFixture)
@@ -97,6 +129,57 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// static void
+// AddRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+BOOST_AUTO_TEST_CASE(Bulk)
+{
+  FibHelper::AddRoutes(getNode("1"), {{Name("/prefix"), getFace("1", "2"), 1},
+                                      {Name("/other"), getFace("1", "2"), 7}});
+
+  nfd::FaceId faceId = getFace("1", "2")->getId();
+  BOOST_CHECK(getNextHops("1", "/prefix") == NextHops{std::make_tuple(faceId, 1)});
+  BOOST_CHECK(getNextHops("1", "/other") == NextHops{std::make_tuple(faceId, 7)});
+}
+
+BOOST_AUTO_TEST_CASE(BulkCommand)
+{
+  FibHelper::SetDirectFibInstall(false);
+  FibHelper::AddRoutes(getNode("1"), {{Name("/prefix"), getFace("1", "2"), 1},
+                                      {Name("/other"), getFace("1", "2"), 7}});
+  FibHelper::SetDirectFibInstall(true);
+
+  // commands are processed by the forwarder once the simulation runs
+  processCommands();
+
+  nfd::FaceId faceId = getFace("1", "2")->getId();
+  BOOST_CHECK(getNextHops("1", "/prefix") == NextHops{std::make_tuple(faceId, 1)});
+  BOOST_CHECK(getNextHops("1", "/other") == NextHops{std::make_tuple(faceId, 7)});
+}
+
+// static void
+// AddRoutes(Ptr<Node> node, const std::vector<RouteGroup>& groups);
+BOOST_AUTO_TEST_CASE(BulkGroup)
+{
+  auto prefixes = make_shared<const std::vector<Name>>(std::vector<Name>{"/other", "/prefix"});
+  FibHelper::AddRoutes(getNode("1"), {{prefixes, {{getFace("1", "2"), 1}}}});
+
+  nfd::FaceId faceId = getFace("1", "2")->getId();
+  BOOST_CHECK(getNextHops("1", "/prefix") == NextHops{std::make_tuple(faceId, 1)});
+  BOOST_CHECK(getNextHops("1", "/other") == NextHops{std::make_tuple(faceId, 1)});
+}
+
+BOOST_AUTO_TEST_CASE(BulkGroupCommand)
+{
+  auto prefixes = make_shared<const std::vector<Name>>(std::vector<Name>{"/prefix"});
+  FibHelper::SetDirectFibInstall(false);
+  FibHelper::AddRoutes(getNode("1"), {{prefixes, {{getFace("1", "2"), 1}}}});
+  FibHelper::SetDirectFibInstall(true);
+  processCommands();
+
+  nfd::FaceId faceId = getFace("1", "2")->getId();
+  BOOST_CHECK(getNextHops("1", "/prefix") == NextHops{std::make_tuple(faceId, 1)});
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
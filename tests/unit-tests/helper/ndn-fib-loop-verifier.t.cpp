@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-fib-loop-verifier.hpp"
+#include "helper/ndn-fib-helper.hpp"
+
+#include "../tests-common.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+class FibLoopVerifierFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  FibLoopVerifierFixture()
+  {
+    //  1 --- 2
+    //   \   /
+    //     3 --- 4
+    createTopology({
+        {"1", "2"},
+        {"2", "3"},
+        {"3", "1"},
+        {"3", "4"}
+      });
+  }
+
+  void
+  addRoute(const std::string& node, const Name& prefix, const std::string& otherNode)
+  {
+    FibHelper::AddRoutes(getNode(node), {{prefix, getFace(node, otherNode), 1}});
+  }
+
+  uint32_t
+  getId(const std::string& node)
+  {
+    return getNode(node)->GetId();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperFibLoopVerifier, FibLoopVerifierFixture)
+
+BOOST_AUTO_TEST_CASE(LoopFree)
+{
+  addRoute("1", "/prefix", "3");
+  addRoute("1", "/prefix", "2");
+  addRoute("2", "/prefix", "3");
+  addRoute("4", "/prefix", "3");
+
+  FibLoopVerifier verifier;
+  BOOST_CHECK(verifier.findLoops("/prefix").empty());
+  BOOST_CHECK(verifier.findLoops("/prefix/data").empty());
+  BOOST_CHECK(verifier.findLoops().empty());
+}
+
+BOOST_AUTO_TEST_CASE(ReturnToInFace)
+{
+  // Interests are never sent back over their in-face, so 1 -> 2 -> 1 is not a loop
+  addRoute("1", "/prefix", "2");
+  addRoute("2", "/prefix", "1");
+  addRoute("2", "/prefix", "3");
+
+  FibLoopVerifier verifier;
+  BOOST_CHECK(verifier.findLoops("/prefix").empty());
+}
+
+BOOST_AUTO_TEST_CASE(Loop)
+{
+  addRoute("1", "/prefix", "2");
+  addRoute("2", "/prefix", "3");
+  addRoute("3", "/prefix", "1");
+  addRoute("4", "/prefix", "3");
+  addRoute("1", "/other", "3");
+
+  FibLoopVerifier verifier;
+  auto loops = verifier.findLoops("/prefix");
+  BOOST_REQUIRE_EQUAL(loops.size(), 1);
+  BOOST_CHECK_EQUAL(loops[0].prefix, Name("/prefix"));
+
+  // rotate to start at node 1
+  auto& nodes = loops[0].nodes;
+  BOOST_REQUIRE_EQUAL(nodes.size(), 3);
+  std::rotate(nodes.begin(), std::find(nodes.begin(), nodes.end(), getId("1")), nodes.end());
+  BOOST_CHECK_EQUAL(nodes[0], getId("1"));
+  BOOST_CHECK_EQUAL(nodes[1], getId("2"));
+  BOOST_CHECK_EQUAL(nodes[2], getId("3"));
+  BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(loops[0]), "/prefix: 1 -> 2 -> 3 -> 1");
+
+  BOOST_CHECK(verifier.findLoops("/other").empty());
+  BOOST_CHECK_EQUAL(verifier.findLoops().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(LongestPrefixMatch)
+{
+  // a default route on node 3 closes the loop for all names under /prefix
+  addRoute("1", "/prefix", "2");
+  addRoute("2", "/prefix", "3");
+  addRoute("3", "/", "1");
+
+  FibLoopVerifier verifier;
+  BOOST_CHECK_EQUAL(verifier.findLoops("/prefix/data").size(), 1);
+  BOOST_CHECK(verifier.findLoops("/other").empty());
+
+  // a more specific route on node 3 takes precedence
+  addRoute("3", "/prefix", "4");
+  BOOST_CHECK(verifier.findLoops("/prefix/data").empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -18,11 +18,14 @@
  **/
 
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-fib-loop-verifier.hpp"
 #include "helper/ndn-stack-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-transport.hpp"
+#include "model/ndn-split-weight-table.hpp"
 
 #include "ns3/channel.h"
 #include "ns3/net-device.h"
@@ -37,10 +40,14 @@
 
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+
 namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TOPO_TXT = boost::filesystem::path(TEST_CONFIG_PATH) / "topo.txt";
+const boost::filesystem::path TEST_ROUTE_CACHE = boost::filesystem::path(TEST_CONFIG_PATH) / "route-cache";
+const boost::filesystem::path TEST_STATISTICS_CSV = boost::filesystem::path(TEST_CONFIG_PATH) / "routing.csv";
 
 class GlobalRoutingHelperFixture : public CleanupFixture
 {
@@ -53,6 +60,159 @@ public:
   ~GlobalRoutingHelperFixture()
   {
     boost::filesystem::remove(TEST_TOPO_TXT);
+    boost::filesystem::remove_all(TEST_ROUTE_CACHE);
+    boost::filesystem::remove(TEST_STATISTICS_CSV);
+    GlobalRoutingHelper::SetNumThreads(1);
+    GlobalRoutingHelper::SetStatisticsFile("");
+    GlobalRoutingHelper::SetRouteCacheDirectory("");
+    GlobalRoutingHelper::SetLfidMemoryBudget(0);
+    GlobalRoutingHelper::SetLfidSplitWeights(false);
+    FibHelper::SetDirectFibInstall(true);
+  }
+
+  void
+  writeGridTopology()
+  {
+    ofstream file1(TEST_TOPO_TXT.string().c_str());
+    file1 << "router\n\n"
+          << "#node city  y x mpi-partition\n"
+          << "G1  NA  1 1 1\n"
+          << "G2  NA  1 2 1\n"
+          << "G3  NA  1 3 1\n"
+          << "G4  NA  2 1 1\n"
+          << "G5  NA  2 2 1\n"
+          << "G6  NA  2 3 1\n"
+          << "G7  NA  3 1 1\n"
+          << "G8  NA  3 2 1\n"
+          << "G9  NA  3 3 1\n\n"
+          << "link\n\n"
+          << "# from  to  capacity  metric  delay queue\n"
+          << "G1      G2  10Mbps    1   1ms 100\n"
+          << "G2      G3  10Mbps    2   1ms 100\n"
+          << "G4      G5  10Mbps    1   1ms 100\n"
+          << "G5      G6  10Mbps    3   1ms 100\n"
+          << "G7      G8  10Mbps    1   1ms 100\n"
+          << "G8      G9  10Mbps    1   1ms 100\n"
+          << "G1      G4  10Mbps    2   1ms 100\n"
+          << "G4      G7  10Mbps    1   1ms 100\n"
+          << "G2      G5  10Mbps    1   1ms 100\n"
+          << "G5      G8  10Mbps    2   1ms 100\n"
+          << "G3      G6  10Mbps    1   1ms 100\n"
+          << "G6      G9  10Mbps    1   1ms 100\n";
+    file1.close();
+  }
+
+  /**
+   * @brief Install NDN stack and global routing on the grid topology with OSPF metrics
+   * @param origins (prefix, node name) pairs announced by the global routers
+   */
+  void
+  setUpGrid(std::initializer_list<std::pair<std::string, std::string>> origins)
+  {
+    writeGridTopology();
+
+    AnnotatedTopologyReader topologyReader("");
+    topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+    topologyReader.Read();
+
+    ndn::StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    topologyReader.ApplyOspfMetric();
+
+    ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+    ndnGlobalRoutingHelper.InstallAll();
+    for (const auto& origin : origins) {
+      ndnGlobalRoutingHelper.AddOrigin(origin.first, origin.second);
+    }
+  }
+
+  /**
+   * @brief Get (face ID, cost) of all next hops for @p prefix on every node
+   */
+  std::map<uint32_t, std::set<std::tuple<nfd::FaceId, uint64_t>>>
+  getNextHops(const Name& prefix)
+  {
+    std::map<uint32_t, std::set<std::tuple<nfd::FaceId, uint64_t>>> nextHops;
+    for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
+      auto& fib = (*node)->GetObject<L3Protocol>()->getForwarder()->getFib();
+      const auto* entry = fib.findExactMatch(prefix);
+      if (entry == nullptr)
+        continue;
+
+      for (const auto& nextHop : entry->getNextHops()) {
+        nextHops[(*node)->GetId()].emplace(nextHop.getFace().getId(), nextHop.getCost());
+      }
+    }
+    return nextHops;
+  }
+
+  /**
+   * @brief Get the split weight of every next hop for @p prefix on every node
+   */
+  std::map<uint32_t, std::map<nfd::FaceId, double>>
+  getSplitWeights(const Name& prefix)
+  {
+    std::map<uint32_t, std::map<nfd::FaceId, double>> splitWeights;
+    for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
+      auto weights = SplitWeightTable::Get(*node)->find(prefix);
+      if (weights == nullptr)
+        continue;
+
+      for (const auto& weight : *weights) {
+        splitWeights[(*node)->GetId()][weight.face] = weight.weight;
+      }
+    }
+    return splitWeights;
+  }
+
+  void
+  eraseRoutes(const Name& prefix)
+  {
+    for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
+      (*node)->GetObject<L3Protocol>()->getForwarder()->getFib().erase(prefix);
+    }
+  }
+
+  /**
+   * @brief Get face of @p node1 towards @p node2
+   */
+  nfd::Face*
+  getFace(const std::string& node1, const std::string& node2)
+  {
+    Ptr<Node> other = Names::Find<Node>(node2);
+    auto ndn = Names::Find<Node>(node1)->GetObject<L3Protocol>();
+    for (auto& face : ndn->getForwarder()->getFaceTable()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(face.getTransport());
+      if (transport == nullptr)
+        continue;
+
+      auto channel = transport->GetNetDevice()->GetChannel();
+      if (channel->GetDevice(0)->GetNode() == other || channel->GetDevice(1)->GetNode() == other)
+        return &face;
+    }
+    return nullptr;
+  }
+
+  void
+  setLinkMetric(const std::string& node1, const std::string& node2, uint16_t metric)
+  {
+    getFace(node1, node2)->setMetric(metric);
+    getFace(node2, node1)->setMetric(metric);
+  }
+
+  size_t
+  countCacheFiles()
+  {
+    return std::distance(boost::filesystem::directory_iterator(TEST_ROUTE_CACHE),
+                         boost::filesystem::directory_iterator());
+  }
+
+  void
+  processCommands()
+  {
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
   }
 };
 
@@ -190,6 +350,412 @@ BOOST_AUTO_TEST_CASE(CalculateRoutesBasedOnLinkDelay)
   }
 }
 
+BOOST_AUTO_TEST_CASE(CalculateAllPossibleRoutes)
+{
+  setUpGrid({{"/prefix", "G9"}});
+
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  auto nextHops = getNextHops("/prefix");
+
+  // G1-G2-G5-G8-G9 and G1-G4-G7-G8-G9
+  std::set<std::tuple<nfd::FaceId, uint64_t>> expected{
+    std::make_tuple(getFace("G1", "G2")->getId(), 5),
+    std::make_tuple(getFace("G1", "G4")->getId(), 5)};
+  BOOST_CHECK_EQUAL(nextHops.size(), 8);
+  BOOST_CHECK(nextHops[Names::Find<Node>("G1")->GetId()] == expected);
+
+  // face metrics are left untouched
+  BOOST_CHECK_EQUAL(getFace("G1", "G2")->getMetric(), 1);
+  BOOST_CHECK_EQUAL(getFace("G1", "G4")->getMetric(), 2);
+
+  eraseRoutes("/prefix");
+  ndn::GlobalRoutingHelper::SetNumThreads(4);
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+
+  BOOST_CHECK(getNextHops("/prefix") == nextHops);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateEcmpRoutes)
+{
+  setUpGrid({{"/prefix", "G9"}});
+
+  ndn::GlobalRoutingHelper::CalculateEcmpRoutes();
+  auto nextHops = getNextHops("/prefix");
+  BOOST_CHECK_EQUAL(nextHops.size(), 8);
+
+  // G1-G2-G5-G8-G9 and G1-G4-G7-G8-G9
+  std::set<std::tuple<nfd::FaceId, uint64_t>> expectedG1{
+    std::make_tuple(getFace("G1", "G2")->getId(), 5),
+    std::make_tuple(getFace("G1", "G4")->getId(), 5)};
+  BOOST_CHECK(nextHops[Names::Find<Node>("G1")->GetId()] == expectedG1);
+
+  // G2-G5-G8-G9 and G2-G3-G6-G9
+  std::set<std::tuple<nfd::FaceId, uint64_t>> expectedG2{
+    std::make_tuple(getFace("G2", "G5")->getId(), 4),
+    std::make_tuple(getFace("G2", "G3")->getId(), 4)};
+  BOOST_CHECK(nextHops[Names::Find<Node>("G2")->GetId()] == expectedG2);
+
+  // G5-G8-G9 only, all other paths cost 4
+  std::set<std::tuple<nfd::FaceId, uint64_t>> expectedG5{
+    std::make_tuple(getFace("G5", "G8")->getId(), 3)};
+  BOOST_CHECK(nextHops[Names::Find<Node>("G5")->GetId()] == expectedG5);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateLfidRoutesParallel)
+{
+  setUpGrid({{"/prefix", "G9"}});
+
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  processCommands();
+  auto sequential = getNextHops("/prefix");
+
+  // all nodes except the producer have a route, G1 has both of its faces
+  BOOST_CHECK_EQUAL(sequential.size(), 8);
+  BOOST_CHECK_EQUAL(sequential[Names::Find<Node>("G1")->GetId()].size(), 2);
+  BOOST_CHECK(FibLoopVerifier().findLoops("/prefix").empty());
+
+  eraseRoutes("/prefix");
+  BOOST_CHECK_EQUAL(getNextHops("/prefix").size(), 0);
+
+  ndn::GlobalRoutingHelper::SetNumThreads(4);
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  processCommands();
+
+  BOOST_CHECK(getNextHops("/prefix") == sequential);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateLfidRoutesCommandPath)
+{
+  setUpGrid({{"/prefix", "G9"}});
+
+  // direct installation does not need the simulation to run
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  auto direct = getNextHops("/prefix");
+  BOOST_CHECK_EQUAL(direct.size(), 8);
+
+  eraseRoutes("/prefix");
+
+  FibHelper::SetDirectFibInstall(false);
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  processCommands();
+
+  BOOST_CHECK(getNextHops("/prefix") == direct);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateLfidRoutesPerOrigin)
+{
+  setUpGrid({{"/prefix1", "G3"}, {"/prefix2", "G7"}});
+
+  // per-origin calculation
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  auto routes1 = getNextHops("/prefix1");
+  auto routes2 = getNextHops("/prefix2");
+  BOOST_CHECK_EQUAL(routes1.size(), 8);
+  BOOST_CHECK_EQUAL(routes2.size(), 8);
+
+  // same as the calculation based on all-pairs distances
+  eraseRoutes("/prefix1");
+  eraseRoutes("/prefix2");
+  ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix1") == routes1);
+  BOOST_CHECK(getNextHops("/prefix2") == routes2);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateLfidRoutesMemoryBudget)
+{
+  setUpGrid({{"/prefix1", "G3"}, {"/prefix2", "G7"}, {"/prefix3", "G9"}});
+
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  auto routes1 = getNextHops("/prefix1");
+  auto routes3 = getNextHops("/prefix3");
+  eraseRoutes("/prefix1");
+  eraseRoutes("/prefix2");
+  eraseRoutes("/prefix3");
+
+  // one dst per batch
+  ndn::GlobalRoutingHelper::SetLfidMemoryBudget(1);
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix1") == routes1);
+  BOOST_CHECK(getNextHops("/prefix3") == routes3);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateLfidRoutes)
+{
+  setUpGrid({{"/prefix", "G9"}});
+
+  ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+  auto initial = getNextHops("/prefix");
+  BOOST_CHECK_EQUAL(initial.size(), 8);
+
+  // fail link for routing, then restore it
+  uint16_t metric = getFace("G6", "G9")->getMetric();
+  setLinkMetric("G6", "G9", std::numeric_limits<uint16_t>::max());
+  ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+  auto failed = getNextHops("/prefix");
+  BOOST_CHECK(failed != initial);
+  BOOST_CHECK_EQUAL(failed[Names::Find<Node>("G6")->GetId()].count(
+                      std::make_tuple(getFace("G6", "G9")->getId(), metric)), 0);
+  BOOST_CHECK(FibLoopVerifier().findLoops("/prefix").empty());
+
+  setLinkMetric("G6", "G9", metric);
+  ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix") == initial);
+
+  // same result as a full calculation
+  setLinkMetric("G6", "G9", std::numeric_limits<uint16_t>::max());
+  eraseRoutes("/prefix");
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix") == failed);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateLfidRoutesOrigins)
+{
+  setUpGrid({{"/prefix1", "G3"}, {"/prefix2", "G7"}});
+
+  ndn::GlobalRoutingHelper::SetLfidSplitWeights(true);
+  ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+  auto routes1 = getNextHops("/prefix1");
+  BOOST_CHECK_EQUAL(routes1.size(), 8);
+  BOOST_CHECK_EQUAL(getNextHops("/prefix2").size(), 8);
+
+  // a withdrawn origin leaves neither routes nor split weights behind
+  Names::Find<Node>("G7")->GetObject<GlobalRouter>()->RemoveLocalPrefix("/prefix2");
+  ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+  BOOST_CHECK_EQUAL(getNextHops("/prefix2").size(), 0);
+  BOOST_CHECK(getNextHops("/prefix1") == routes1);
+  for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
+    BOOST_CHECK(SplitWeightTable::Get(*node)->find("/prefix2") == nullptr);
+  }
+
+  // a moved origin gets the same routes as with a fresh calculation
+  Names::Find<Node>("G3")->GetObject<GlobalRouter>()->RemoveLocalPrefix("/prefix1");
+  ndn::GlobalRoutingHelper().AddOrigin("/prefix1", "G9");
+  ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+  auto moved = getNextHops("/prefix1");
+  BOOST_CHECK_EQUAL(moved.size(), 8);
+  BOOST_CHECK_EQUAL(moved.count(Names::Find<Node>("G9")->GetId()), 0);
+
+  eraseRoutes("/prefix1");
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix1") == moved);
+}
+
+BOOST_AUTO_TEST_CASE(UpdateLfidRoutesAnycast)
+{
+  setUpGrid({{"/prefix", "G7"}, {"/prefix", "G9"}, {"/seven", "G7"}});
+
+  ndn::GlobalRoutingHelper::SetLfidSplitWeights(true);
+  ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+
+  // G5 reaches both origins via G8
+  uint32_t g5 = Names::Find<Node>("G5")->GetId();
+  std::tuple<nfd::FaceId, uint64_t> viaG8(getFace("G5", "G8")->getId(), 3);
+  BOOST_CHECK_EQUAL(getNextHops("/seven")[g5].count(viaG8), 1);
+  BOOST_CHECK_EQUAL(getNextHops("/prefix")[g5].count(viaG8), 1);
+
+  // without G7-G8 and G6-G9, G8 only reaches G7 through G5, but still reaches G9
+  setLinkMetric("G7", "G8", std::numeric_limits<uint16_t>::max());
+  setLinkMetric("G6", "G9", std::numeric_limits<uint16_t>::max());
+  ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+  BOOST_CHECK_EQUAL(getNextHops("/seven")[g5].count(viaG8), 0);
+
+  auto updated = getNextHops("/prefix");
+  auto updatedWeights = getSplitWeights("/prefix");
+  BOOST_CHECK_EQUAL(updated[g5].count(viaG8), 1);
+  BOOST_CHECK_GT(updatedWeights[g5][getFace("G5", "G8")->getId()], 0);
+
+  // same result as a full calculation
+  eraseRoutes("/prefix");
+  for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
+    SplitWeightTable::Get(*node)->clear();
+  }
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix") == updated);
+  BOOST_CHECK(getSplitWeights("/prefix") == updatedWeights);
+}
+
+BOOST_AUTO_TEST_CASE(RouteCache)
+{
+  setUpGrid({{"/prefix", "G9"}});
+
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  auto calculated = getNextHops("/prefix");
+  eraseRoutes("/prefix");
+
+  // first run saves the routes
+  ndn::GlobalRoutingHelper::SetRouteCacheDirectory(TEST_ROUTE_CACHE.string());
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix") == calculated);
+  BOOST_CHECK_EQUAL(countCacheFiles(), 1);
+
+  // second run loads them
+  eraseRoutes("/prefix");
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix") == calculated);
+  BOOST_CHECK_EQUAL(countCacheFiles(), 1);
+
+  // a header whose group counts wrap around in 32 bits is rejected, and the routes are calculated
+  {
+    auto fileName = boost::filesystem::directory_iterator(TEST_ROUTE_CACHE)->path().string();
+    std::fstream file(fileName, std::ios::in | std::ios::out | std::ios::binary);
+    const std::streamoff countsOffset = 32; // nGroups and nGroupPrefixes
+    uint32_t counts[2];
+    file.seekg(countsOffset);
+    file.read(reinterpret_cast<char*>(counts), sizeof(counts));
+    counts[1] += counts[0] + 1;
+    counts[0] = std::numeric_limits<uint32_t>::max();
+    file.seekp(countsOffset);
+    file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+  }
+  eraseRoutes("/prefix");
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix") == calculated);
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::GetStatistics().isCached, false);
+  BOOST_CHECK_EQUAL(countCacheFiles(), 1);
+
+  // other algorithm or other metrics use a different file
+  eraseRoutes("/prefix");
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK_EQUAL(countCacheFiles(), 2);
+
+  eraseRoutes("/prefix");
+  setLinkMetric("G6", "G9", 5);
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix") != calculated);
+  BOOST_CHECK_EQUAL(countCacheFiles(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(LfidSplitWeights)
+{
+  setUpGrid({{"/prefix", "G9"}});
+
+  ndn::GlobalRoutingHelper::SetLfidSplitWeights(true);
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+
+  // one weight per next hop, normalized on every node
+  auto nextHops = getNextHops("/prefix");
+  BOOST_CHECK_EQUAL(nextHops.size(), 8);
+  for (const auto& node : nextHops) {
+    auto weights = SplitWeightTable::Get(NodeList::GetNode(node.first))->find("/prefix");
+    BOOST_REQUIRE(weights != nullptr);
+    BOOST_CHECK_EQUAL(weights->size(), node.second.size());
+
+    double sum = 0;
+    for (const auto& weight : *weights) {
+      BOOST_CHECK_GT(weight.weight, 0);
+      BOOST_CHECK(std::any_of(node.second.begin(), node.second.end(),
+                              [&weight] (const std::tuple<nfd::FaceId, uint64_t>& nextHop) {
+                                return std::get<0>(nextHop) == weight.face;
+                              }));
+      sum += weight.weight;
+    }
+    BOOST_CHECK_CLOSE(sum, 1, 1e-6);
+  }
+  BOOST_CHECK(SplitWeightTable::Get(Names::Find<Node>("G9"))->find("/prefix") == nullptr);
+
+  // both next hops of G1 have cost 5, but G2 has three next hops towards G9 and G4 only two
+  Ptr<Node> g1 = Names::Find<Node>("G1");
+  BOOST_CHECK_GT(SplitWeightTable::Get(g1)->getWeight("/prefix", getFace("G1", "G2")->getId()),
+                 SplitWeightTable::Get(g1)->getWeight("/prefix", getFace("G1", "G4")->getId()));
+
+  // weights follow incremental updates
+  setLinkMetric("G6", "G9", std::numeric_limits<uint16_t>::max());
+  ndn::GlobalRoutingHelper::UpdateLFIDRoutes();
+  Ptr<Node> g6 = Names::Find<Node>("G6");
+  BOOST_CHECK_EQUAL(SplitWeightTable::Get(g6)->getWeight("/prefix", getFace("G6", "G9")->getId()),
+                    0);
+  BOOST_CHECK_EQUAL(SplitWeightTable::Get(g6)->find("/prefix")->size(),
+                    getNextHops("/prefix")[g6->GetId()].size());
+}
+
+BOOST_AUTO_TEST_CASE(LfidSplitWeightsAnycast)
+{
+  setUpGrid({{"/prefix", "G3"}, {"/prefix", "G7"}, {"/other", "G7"}});
+
+  ndn::GlobalRoutingHelper::SetLfidSplitWeights(true);
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+
+  // every next hop towards either origin has a weight, normalized over the whole entry
+  auto nextHops = getNextHops("/prefix");
+  auto weights = getSplitWeights("/prefix");
+  BOOST_CHECK_EQUAL(nextHops.size(), 9);
+  for (const auto& node : nextHops) {
+    const auto& nodeWeights = weights[node.first];
+    BOOST_CHECK_EQUAL(nodeWeights.size(), node.second.size());
+
+    double sum = 0;
+    for (const auto& nextHop : node.second) {
+      auto weight = nodeWeights.find(std::get<0>(nextHop));
+      BOOST_REQUIRE(weight != nodeWeights.end());
+      BOOST_CHECK_GT(weight->second, 0);
+      sum += weight->second;
+    }
+    BOOST_CHECK_CLOSE(sum, 1, 1e-6);
+  }
+
+  // G5 is closest to G3 via G2 and to G7 via G4
+  uint32_t g5 = Names::Find<Node>("G5")->GetId();
+  BOOST_CHECK_GT(weights[g5][getFace("G5", "G2")->getId()], 0);
+  BOOST_CHECK_GT(weights[g5][getFace("G5", "G4")->getId()], 0);
+  BOOST_CHECK(getSplitWeights("/other") != weights);
+
+  // origins of one prefix are kept in one batch, so the weights do not depend on the budget
+  eraseRoutes("/prefix");
+  eraseRoutes("/other");
+  for (auto node = NodeList::Begin(); node != NodeList::End(); node++) {
+    SplitWeightTable::Get(*node)->clear();
+  }
+  ndn::GlobalRoutingHelper::SetLfidMemoryBudget(1);
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+  BOOST_CHECK(getNextHops("/prefix") == nextHops);
+  BOOST_CHECK(getSplitWeights("/prefix") == weights);
+}
+
+BOOST_AUTO_TEST_CASE(Statistics)
+{
+  setUpGrid({{"/prefix", "G9"}});
+
+  ndn::GlobalRoutingHelper::SetStatisticsFile(TEST_STATISTICS_CSV.string());
+  ndn::GlobalRoutingHelper::CalculateLFIDRoutes();
+
+  size_t nNextHops = 0;
+  for (const auto& node : getNextHops("/prefix")) {
+    nNextHops += node.second.size();
+  }
+
+  const RoutingStatistics& lfid = ndn::GlobalRoutingHelper::GetStatistics();
+  BOOST_CHECK_EQUAL(lfid.algorithm, "lfid");
+  BOOST_CHECK_EQUAL(lfid.isCached, false);
+  BOOST_CHECK_EQUAL(lfid.nNodes, 9);
+  BOOST_CHECK_EQUAL(lfid.nDestinations, 1);
+  BOOST_CHECK_EQUAL(lfid.nEntries, 8);
+  BOOST_CHECK_EQUAL(lfid.nNextHops, nNextHops);
+  BOOST_CHECK_LE(lfid.nUpwardNextHops, lfid.nUpwardCandidates);
+  BOOST_CHECK_GE(lfid.getMeanStretch(), 1);
+  BOOST_CHECK_GE(lfid.totalTime, lfid.spfTime + lfid.installTime);
+
+  eraseRoutes("/prefix");
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  const RoutingStatistics& shortestPath = ndn::GlobalRoutingHelper::GetStatistics();
+  BOOST_CHECK_EQUAL(shortestPath.algorithm, "shortest-path");
+  BOOST_CHECK_EQUAL(shortestPath.nNextHops, 8);
+  BOOST_CHECK_EQUAL(shortestPath.nextHopsHistogram.at(1), 8);
+  BOOST_CHECK_EQUAL(shortestPath.stretchHistogram.at(0), 8);
+  BOOST_CHECK_EQUAL(shortestPath.nUpwardCandidates, 0);
+
+  // column names and one row per calculation
+  std::ifstream file(TEST_STATISTICS_CSV.string());
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  BOOST_REQUIRE_EQUAL(lines.size(), 3);
+  BOOST_CHECK_EQUAL(lines[0].compare(0, 10, "algorithm,"), 0);
+  BOOST_CHECK_EQUAL(lines[1].compare(0, 5, "lfid,"), 0);
+  BOOST_CHECK_EQUAL(lines[2].compare(0, 14, "shortest-path,"), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-traffic-engineering-helper.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-fib-loop-verifier.hpp"
+
+#include "../tests-common.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+class TrafficEngineeringHelperFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TrafficEngineeringHelperFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+    Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+    //      2
+    //    /   \      (all links have metric 1)
+    //  1       4
+    //    \   /
+    //      3
+    createTopology({
+        {"1", "2"},
+        {"2", "4"},
+        {"1", "3"},
+        {"3", "4"}
+      });
+
+    GlobalRoutingHelper ndnGlobalRoutingHelper;
+    ndnGlobalRoutingHelper.InstallAll();
+    ndnGlobalRoutingHelper.AddOrigins("/prefix", getNode("4"));
+    GlobalRoutingHelper::UpdateLFIDRoutes();
+  }
+
+  void
+  addTraffic(const std::string& frequency)
+  {
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", frequency}},
+            "0s", "100s"},
+        {"4", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  uint64_t
+  getMetric(const std::string& node1, const std::string& node2)
+  {
+    return getFace(node1, node2)->getMetric();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperTrafficEngineeringHelper, TrafficEngineeringHelperFixture)
+
+BOOST_AUTO_TEST_CASE(Idle)
+{
+  addTraffic("1");
+
+  TrafficEngineeringHelper te;
+  te.InstallAll();
+  BOOST_CHECK_EQUAL(te.Optimize(), 0); // no time passed
+
+  Simulator::Stop(Seconds(3.5));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(te.GetNUpdates(), 0);
+  BOOST_CHECK_GT(std::max(te.GetUtilization(getNode("2"), getNode("4")),
+                          te.GetUtilization(getNode("3"), getNode("4"))), 0);
+  BOOST_CHECK_LT(te.GetUtilization(getNode("2"), getNode("4")), 1.0 / 3);
+  BOOST_CHECK_EQUAL(te.GetUtilization(getNode("1"), getNode("4")), 0); // no such link
+  BOOST_CHECK_EQUAL(getMetric("1", "2"), 1);
+  BOOST_CHECK_EQUAL(getMetric("2", "4"), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Congestion)
+{
+  // ~1.3 Mbps of Data
+  addTraffic("150");
+
+  TrafficEngineeringHelper te;
+  te.SetDamping(0);
+  te.InstallAll();
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  // the path used by the consumer is overloaded
+  BOOST_CHECK_EQUAL(te.GetNUpdates(), 1);
+  bool isVia2 = te.GetUtilization(getNode("2"), getNode("4")) > 1;
+  std::string used = isVia2 ? "2" : "3";
+  std::string other = isVia2 ? "3" : "2";
+  BOOST_CHECK_GT(te.GetUtilization(getNode(used), getNode("4")), 1);
+  BOOST_CHECK_LT(te.GetUtilization(getNode(other), getNode("4")), 1.0 / 3);
+
+  // both faces of the overloaded links get a high metric, the others keep theirs
+  BOOST_CHECK_GE(getMetric(used, "4"), 500);
+  BOOST_CHECK_EQUAL(getMetric("4", used), getMetric(used, "4"));
+  BOOST_CHECK_EQUAL(getMetric(other, "4"), 1);
+  BOOST_CHECK_EQUAL(getMetric("1", other), 1);
+
+  // routes were updated incrementally and stay loop-free
+  BOOST_CHECK(FibLoopVerifier().findLoops("/prefix").empty());
+  const auto& statistics = GlobalRoutingHelper::GetStatistics();
+  BOOST_CHECK_EQUAL(statistics.algorithm, "lfid-update");
+}
+
+BOOST_AUTO_TEST_CASE(FailedLink)
+{
+  addTraffic("150");
+  getFace("2", "4")->setMetric(std::numeric_limits<uint16_t>::max());
+  getFace("4", "2")->setMetric(std::numeric_limits<uint16_t>::max());
+  GlobalRoutingHelper::UpdateLFIDRoutes();
+
+  TrafficEngineeringHelper te;
+  te.SetDamping(0);
+  te.InstallAll();
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  // the only remaining path is overloaded, the failed link stays failed
+  BOOST_CHECK_GE(getMetric("3", "4"), 500);
+  BOOST_CHECK_EQUAL(getMetric("2", "4"), std::numeric_limits<uint16_t>::max());
+  BOOST_CHECK_EQUAL(getMetric("4", "2"), std::numeric_limits<uint16_t>::max());
+}
+
+BOOST_AUTO_TEST_CASE(SeveralInstalls)
+{
+  addTraffic("150");
+
+  // 1-3 and 2-4 connect nodes of different calls, 2 and 4 are installed twice
+  TrafficEngineeringHelper te;
+  te.SetDamping(0);
+  te.Install(NodeContainer(getNode("1"), getNode("2")));
+  te.Install(NodeContainer(getNode("3"), getNode("4")));
+  te.Install(NodeContainer(getNode("2"), getNode("4")));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  // same as with InstallAll(): all links are managed, and traffic is counted once
+  BOOST_CHECK_EQUAL(te.GetNUpdates(), 1);
+  bool isVia2 = te.GetUtilization(getNode("2"), getNode("4")) > 1;
+  std::string used = isVia2 ? "2" : "3";
+  BOOST_CHECK_GT(te.GetUtilization(getNode("1"), getNode(used)), 1.0 / 3);
+  BOOST_CHECK_GT(te.GetUtilization(getNode(used), getNode("4")), 1);
+  BOOST_CHECK_LT(te.GetUtilization(getNode(used), getNode("4")), 2);
+  BOOST_CHECK_GE(getMetric(used, "4"), 500);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
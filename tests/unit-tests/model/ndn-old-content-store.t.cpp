@@ -67,6 +67,58 @@ BOOST_AUTO_TEST_CASE(RandomPolicy)
   BOOST_CHECK(entries["1"] != entries["2"]); // this test has a small chance of failing
 }
 
+static void
+recordMaxBytes(uint64_t* maxBytes, uint64_t oldValue, uint64_t newValue)
+{
+  *maxBytes = std::max(*maxBytes, newValue);
+}
+
+BOOST_AUTO_TEST_CASE(MaxBytes)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::QueueBase::MaxSize", StringValue("20p"));
+
+  getStackHelper().SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", "0", "MaxBytes", "10000");
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  auto cs = getNode("1")->GetObject<ContentStore>();
+  uint64_t maxTracedBytes = 0;
+  cs->TraceConnectWithoutContext("SizeBytes", MakeBoundCallback(&recordMaxBytes, &maxTracedBytes));
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  uint64_t nBytes = 0;
+  uint64_t dataSize = 0;
+  for (auto it = cs->Begin(); it != cs->End(); it = cs->Next(it)) {
+    dataSize = it->GetData()->wireEncode().size();
+    nBytes += dataSize;
+  }
+
+  BOOST_CHECK_EQUAL(cs->GetSizeBytes(), nBytes);
+  BOOST_CHECK_LE(nBytes, 10000u);
+  BOOST_CHECK_GT(nBytes + dataSize, 10000u); // the 100 Data packets did not fit
+  BOOST_CHECK_GE(maxTracedBytes, nBytes);
+  BOOST_CHECK_LE(maxTracedBytes, 10000u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
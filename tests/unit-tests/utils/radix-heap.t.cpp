@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/radix-heap.hpp"
+
+#include "../tests-common.hpp"
+
+#include <random>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsRadixHeap)
+
+BOOST_AUTO_TEST_CASE(SelectedQueue)
+{
+  BOOST_CHECK((std::is_same<ShortestPathQueue<uint32_t, int>, RadixHeap<uint32_t, int>>::value));
+  BOOST_CHECK((std::is_same<ShortestPathQueue<double, int>, BinaryHeap<double, int>>::value));
+}
+
+BOOST_AUTO_TEST_CASE(MonotoneSequence)
+{
+  RadixHeap<uint32_t, int> heap;
+  BinaryHeap<uint32_t, int> reference;
+  std::mt19937 random(1);
+
+  // Dijkstra-like: every pushed key is the last popped key plus a "weight"
+  uint32_t last = 0;
+  for (int i = 0; i < 5000; i++) {
+    for (int k = random() % 4; k > 0; k--) {
+      uint32_t key = last + random() % 1000;
+      heap.push(key, i);
+      reference.push(key, i);
+    }
+    if (heap.empty())
+      continue;
+
+    BOOST_REQUIRE_EQUAL(heap.size(), reference.size());
+    BOOST_REQUIRE_EQUAL(heap.top().first, reference.top().first);
+    last = heap.top().first;
+    heap.pop();
+    reference.pop();
+  }
+
+  while (!heap.empty()) {
+    BOOST_REQUIRE_EQUAL(heap.top().first, reference.top().first);
+    heap.pop();
+    reference.pop();
+  }
+  BOOST_CHECK(reference.empty());
+
+  heap.clear();
+  heap.push(0, 0);
+  BOOST_CHECK_EQUAL(heap.top().first, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,276 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "utils/trie/fifo-policy.hpp"
+#include "utils/trie/lfu-policy.hpp"
+#include "utils/trie/random-policy.hpp"
+#include "utils/trie/persistent-policy.hpp"
+#include "utils/trie/multi-policy.hpp"
+#include "utils/trie/aggregate-stats-policy.hpp"
+#include "utils/trie/component-dictionary.hpp"
+
+#include "../tests-common.hpp"
+
+#include <boost/mpl/vector.hpp>
+
+#include <random>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+// in the MaxBytes test, a payload is its own size in bytes
+template<>
+struct payload_bytes_traits<non_pointer_traits<size_t>> {
+  static size_t
+  bytes(const size_t& payload)
+  {
+    return payload;
+  }
+};
+
+} // namespace ndnSIM
+
+typedef ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<int>,
+                                 ndnSIM::lru_policy_traits> Trie;
+typedef ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<int>, ndnSIM::lru_policy_traits,
+                                 ndnSIM::interned_key_traits> InternedTrie;
+
+BOOST_AUTO_TEST_SUITE(UtilsTrie)
+
+BOOST_AUTO_TEST_CASE(ComponentHash)
+{
+  ndnSIM::trie_key_hash<name::Component> hash;
+  BOOST_CHECK_EQUAL(hash(name::Component("component")), hash(name::Component("component")));
+  BOOST_CHECK_NE(hash(name::Component("component")), hash(name::Component("componenT")));
+  BOOST_CHECK_NE(hash(name::Component("")), hash(name::Component(std::string(1, '\0'))));
+
+  // all value bytes (also beyond the first 8) and the type matter
+  BOOST_CHECK_NE(hash(name::Component("0123456789abcdef-1")),
+                 hash(name::Component("0123456789abcdef-2")));
+  BOOST_CHECK_NE(hash(name::Component::fromSequenceNumber(1)),
+                 hash(name::Component::fromNumber(1)));
+}
+
+BOOST_AUTO_TEST_CASE(ManyNames)
+{
+  Trie trie;
+  trie.getPolicy().set_max_size(0);
+
+  std::vector<Name> names;
+  std::mt19937 random(1);
+  for (int i = 0; i < 2000; i++) {
+    Name name("/prefix");
+    for (int depth = random() % 6; depth > 0; depth--) {
+      name.append("component-" + std::to_string(random() % 4));
+    }
+    name.appendSequenceNumber(i);
+    names.push_back(name);
+    BOOST_REQUIRE(trie.insert(name, i + 1).second);
+  }
+  BOOST_CHECK(!trie.insert(names.front(), 1).second);
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), names.size());
+
+  for (size_t i = 0; i < names.size(); i++) {
+    BOOST_REQUIRE(trie.find_exact(names[i]) != trie.end());
+    BOOST_CHECK_EQUAL(trie.find_exact(names[i])->payload(), static_cast<int>(i + 1));
+    BOOST_CHECK_EQUAL(trie.longest_prefix_match(Name(names[i]).append("suffix"))->payload(),
+                      static_cast<int>(i + 1));
+    BOOST_CHECK(trie.find_exact(names[i].getPrefix(-1)) == trie.end());
+  }
+
+  // prefixes without a payload of their own
+  BOOST_CHECK(trie.find_exact("/prefix") == trie.end());
+  BOOST_CHECK(trie.deepest_prefix_match("/prefix") != trie.end());
+  BOOST_CHECK(trie.deepest_prefix_match("/other") == trie.end());
+
+  for (size_t i = 0; i < names.size(); i += 2) {
+    trie.erase(names[i]);
+  }
+  for (size_t i = 0; i < names.size(); i++) {
+    BOOST_CHECK_EQUAL(trie.find_exact(names[i]) == trie.end(), i % 2 == 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SameValueOtherType)
+{
+  Trie trie;
+  trie.insert(Name("/prefix").appendSequenceNumber(1), 1);
+
+  BOOST_CHECK(trie.find_exact(Name("/prefix").appendSequenceNumber(1)) != trie.end());
+  BOOST_CHECK(trie.find_exact(Name("/prefix").appendNumber(1)) == trie.end());
+  BOOST_CHECK(trie.find_exact(Name("/prefix").appendSegment(1)) == trie.end());
+
+  trie.insert(Name("/prefix").appendNumber(1), 2);
+  BOOST_CHECK_EQUAL(trie.find_exact(Name("/prefix").appendSequenceNumber(1))->payload(), 1);
+  BOOST_CHECK_EQUAL(trie.find_exact(Name("/prefix").appendNumber(1))->payload(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Fanout)
+{
+  Trie trie;
+  trie.getPolicy().set_max_size(0);
+  BOOST_CHECK_EQUAL(trie.getTrie().node_count(), 1u);
+
+  // children of /prefix move from the node itself to a hash table and back
+  for (int nChildren : {1, 4, 5, 100, 3, 2, 0}) {
+    for (int i = 0; i < 100; i++) {
+      Name name = Name("/prefix").appendNumber(i);
+      if (i < nChildren)
+        trie.insert(name, i + 1);
+      else
+        trie.erase(name);
+    }
+
+    BOOST_CHECK_EQUAL(trie.getPolicy().size(), static_cast<size_t>(nChildren));
+    BOOST_CHECK_EQUAL(trie.getTrie().node_count(),
+                      static_cast<size_t>(nChildren == 0 ? 1 : nChildren + 2));
+    for (int i = 0; i < 100; i++) {
+      auto item = trie.find_exact(Name("/prefix").appendNumber(i));
+      BOOST_CHECK_EQUAL(item != trie.end(), i < nChildren);
+    }
+
+    int nPayloads = 0;
+    Trie::parent_trie::recursive_iterator item(trie.getTrie()), end(0);
+    for (; item != end; item++) {
+      nPayloads += item->payload() != 0;
+    }
+    BOOST_CHECK_EQUAL(nPayloads, nChildren);
+  }
+
+  for (int i = 0; i < 1000; i++) {
+    trie.insert(Name("/prefix").appendNumber(i % 10).appendNumber(i), i + 1);
+  }
+  BOOST_CHECK_EQUAL(trie.getTrie().node_count(), 1012u);
+  BOOST_CHECK_GT(trie.getTrie().allocated_bytes(), 1012 * sizeof(Trie::parent_trie));
+
+  trie.clear();
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 0u);
+  BOOST_CHECK_EQUAL(trie.getTrie().node_count(), 1u);
+  BOOST_CHECK(trie.find_exact(Name("/prefix").appendNumber(1).appendNumber(1)) == trie.end());
+
+  trie.insert("/prefix", 1);
+  BOOST_CHECK_EQUAL(trie.getTrie().node_count(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(InternedKeys)
+{
+  ndnSIM::component_dictionary& dictionary = ndnSIM::component_dictionary::global();
+  size_t nComponents = dictionary.size();
+  {
+    InternedTrie trie1;
+    InternedTrie trie2;
+    size_t nRootComponents = dictionary.size();
+
+    Name name = Name("/interned-prefix").appendSequenceNumber(1);
+    trie1.insert(name, 1);
+    BOOST_CHECK_EQUAL(dictionary.size(), nRootComponents + 2);
+    BOOST_CHECK_EQUAL(trie1.find_exact(name)->key(), name.get(-1));
+
+    // both tries refer to the same components
+    trie2.insert(name, 2);
+    BOOST_CHECK_EQUAL(dictionary.size(), nRootComponents + 2);
+    BOOST_CHECK_EQUAL(trie1.find_exact(name)->payload(), 1);
+    BOOST_CHECK_EQUAL(trie2.find_exact(name)->payload(), 2);
+
+    // components that are not in the dictionary are in none of the tries
+    BOOST_CHECK(trie1.find_exact("/interned-prefix/unknown") == trie1.end());
+    BOOST_CHECK(trie1.find_exact(Name("/interned-prefix").appendNumber(1)) == trie1.end());
+    BOOST_CHECK(trie1.deepest_prefix_match("/interned-prefix") != trie1.end());
+
+    trie2.insert(Name("/interned-prefix").appendNumber(1), 3);
+    BOOST_CHECK_EQUAL(dictionary.size(), nRootComponents + 3);
+    BOOST_CHECK(trie1.find_exact(Name("/interned-prefix").appendNumber(1)) == trie1.end());
+    BOOST_CHECK_EQUAL(trie2.find_exact(Name("/interned-prefix").appendNumber(1))->payload(), 3);
+
+    // the components stay until the last trie releases them
+    trie1.erase(name);
+    BOOST_CHECK_EQUAL(dictionary.size(), nRootComponents + 3);
+    BOOST_CHECK(trie1.find_exact(name) == trie1.end());
+    BOOST_CHECK_EQUAL(trie2.find_exact(name)->payload(), 2);
+
+    trie2.erase(name);
+    BOOST_CHECK_EQUAL(dictionary.size(), nRootComponents + 2);
+
+    trie1.insert(name, 4);
+    BOOST_CHECK_EQUAL(dictionary.size(), nRootComponents + 3);
+    BOOST_CHECK_EQUAL(trie1.find_exact(name)->payload(), 4);
+  }
+  BOOST_CHECK_EQUAL(dictionary.size(), nComponents);
+}
+
+typedef boost::mpl::vector<ndnSIM::lru_policy_traits, ndnSIM::fifo_policy_traits,
+                           ndnSIM::lfu_policy_traits, ndnSIM::random_policy_traits,
+                           ndnSIM::persistent_policy_traits,
+                           ndnSIM::multi_policy_traits<
+                             boost::mpl::vector2<ndnSIM::lru_policy_traits,
+                                                 ndnSIM::aggregate_stats_policy_traits>>>
+  BytePolicies;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(MaxBytes, Policy, BytePolicies)
+{
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<size_t>, Policy> BytesTrie;
+  BytesTrie trie;
+  trie.getPolicy().set_max_size(0);
+  trie.getPolicy().set_max_bytes(1000);
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_max_bytes(), 1000u);
+
+  size_t nInserted = 0;
+  for (size_t i = 0; i < 100; i++) {
+    Name name = Name("/prefix").appendNumber(i);
+    size_t bytes = i % 3 == 0 ? 300 : 10 + i;
+    size_t sizeBefore = trie.getPolicy().size();
+    size_t bytesBefore = trie.getPolicy().get_size_bytes();
+    if (trie.insert(name, bytes).second) {
+      nInserted++;
+      BOOST_CHECK(trie.find_exact(name) != trie.end());
+    }
+    else {
+      // a rejected item does not evict anything
+      BOOST_CHECK_EQUAL(trie.getPolicy().size(), sizeBefore);
+      BOOST_CHECK_EQUAL(trie.getPolicy().get_size_bytes(), bytesBefore);
+    }
+
+    size_t nBytes = 0;
+    typename BytesTrie::parent_trie::recursive_iterator item(trie.getTrie()), end(0);
+    for (; item != end; item++) {
+      nBytes += item->payload();
+    }
+    BOOST_CHECK_EQUAL(trie.getPolicy().get_size_bytes(), nBytes);
+    BOOST_CHECK_LE(nBytes, 1000u);
+  }
+  BOOST_CHECK_GT(nInserted, 0u);
+  BOOST_CHECK_LT(trie.getPolicy().size(), 100u);
+
+  // an item larger than the limit does not evict anything
+  size_t nBytes = trie.getPolicy().get_size_bytes();
+  BOOST_CHECK(!trie.insert("/too-large", 1001).second);
+  BOOST_CHECK(trie.find_exact("/too-large") == trie.end());
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_size_bytes(), nBytes);
+
+  trie.clear();
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_size_bytes(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -37,6 +37,10 @@
 #include <mach-o/ldsyms.h>
 #endif
 
+#include <fstream>
+#include <limits>
+#include <string>
+
 /**
  * @ingroup ndn-helpers
  * @brief Utility class to evaluate current usage of RAM
@@ -90,6 +94,41 @@ public:
     }
 
     return t_info.resident_size;
+#endif
+    // other systems are not yet supported
+    return -1;
+  }
+
+  /**
+   * @brief Get peak memory utilization (high-water mark of the resident set size) in bytes
+   */
+  static inline int64_t
+  GetPeak()
+  {
+#if defined(__linux__)
+    // /proc/[pid]/status contains the line "VmHWM:    <peak resident set size> kB"
+    std::ifstream is("/proc/self/status");
+    std::string key;
+    while (is >> key) {
+      if (key == "VmHWM:") {
+        int64_t kilobytes;
+        is >> kilobytes;
+        return kilobytes * 1024;
+      }
+      is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    return -1;
+
+#elif defined(__APPLE__)
+    struct mach_task_basic_info t_info;
+    mach_msg_type_number_t t_info_count = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (KERN_SUCCESS
+        != task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&t_info, &t_info_count)) {
+      return -1; // something is wrong
+    }
+
+    return t_info.resident_size_max;
 #endif
     // other systems are not yet supported
     return -1;
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PARALLEL_FOR_H
+#define NDN_PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Resolve a user-supplied thread count (0 means "all hardware threads")
+ */
+inline uint32_t
+GetNumWorkerThreads(uint32_t nThreads)
+{
+  if (nThreads == 0) {
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return nThreads;
+}
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Call @p func(worker, i) for every i in [0, n) using up to @p nThreads threads
+ *
+ * Indices are handed out one at a time, so work items of uneven cost are balanced across
+ * the workers.  @p worker is in [0, GetNumWorkerThreads(nThreads)) and identifies the calling
+ * thread, so per-thread scratch state can be kept outside of @p func.  With a single thread,
+ * everything runs inline on the calling thread.
+ *
+ * @p func must not create, copy, or destroy ns3::Ptr objects: their reference counts are
+ * not thread-safe.
+ */
+template<class Function>
+inline void
+ParallelForWorkers(size_t n, uint32_t nThreads, const Function& func)
+{
+  nThreads = static_cast<uint32_t>(std::min<size_t>(GetNumWorkerThreads(nThreads), n));
+
+  if (nThreads <= 1) {
+    for (size_t i = 0; i < n; i++) {
+      func(0, i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  auto worker = [&] (uint32_t id) {
+    for (size_t i = next++; i < n; i = next++) {
+      func(id, i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads - 1);
+  for (uint32_t t = 1; t < nThreads; t++) {
+    threads.emplace_back(worker, t);
+  }
+  worker(0);
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Call @p func(i) for every i in [0, n) using up to @p nThreads threads
+ * @sa ParallelForWorkers
+ */
+template<class Function>
+inline void
+ParallelFor(size_t n, uint32_t nThreads, const Function& func)
+{
+  ParallelForWorkers(n, nThreads, [&func] (uint32_t, size_t i) {
+    func(i);
+  });
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PARALLEL_FOR_H
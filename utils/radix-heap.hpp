@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RADIX_HEAP_H
+#define NDN_RADIX_HEAP_H
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ns3/assert.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Monotone min-priority queue for unsigned integer keys (radix heap)
+ *
+ * Every pushed key must not be smaller than the last popped key, which always holds for the
+ * tentative distances of Dijkstra's algorithm with non-negative edge weights.  An item is kept
+ * in the bucket given by the highest bit in which its key differs from the last popped key, so
+ * push() is O(1) and every item is moved to a lower bucket at most once per bit of the key.
+ *
+ * Like std::priority_queue, the queue has no decrease-key: push the vertex again, and skip
+ * stale entries when they are popped.
+ */
+template<class Key, class Value>
+class RadixHeap {
+  static_assert(std::is_unsigned<Key>::value && sizeof(Key) <= sizeof(unsigned long long),
+                "RadixHeap requires an unsigned integer key");
+
+public:
+  typedef std::pair<Key, Value> value_type;
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  void
+  push(Key key, const Value& value)
+  {
+    NS_ASSERT_MSG(key >= m_last, "RadixHeap keys must be monotone");
+    m_buckets[getBucket(key)].emplace_back(key, value);
+    m_size++;
+  }
+
+  /**
+   * @brief Get an item with the smallest key (must not be empty)
+   */
+  const value_type&
+  top()
+  {
+    pull();
+    return m_buckets[0].back();
+  }
+
+  void
+  pop()
+  {
+    pull();
+    m_buckets[0].pop_back();
+    m_size--;
+  }
+
+  /**
+   * @brief Remove all items and accept any key again, keeping the allocated memory
+   */
+  void
+  clear()
+  {
+    for (auto& bucket : m_buckets) {
+      bucket.clear();
+    }
+    m_last = 0;
+    m_size = 0;
+  }
+
+private:
+  size_t
+  getBucket(Key key) const
+  {
+    unsigned long long diff = key ^ m_last;
+    return diff == 0 ? 0 : std::numeric_limits<unsigned long long>::digits - __builtin_clzll(diff);
+  }
+
+  /*
+   * Make bucket 0 non-empty: the items of the first non-empty bucket all differ from the new
+   * minimum only in lower bits, so they are spread over lower buckets.
+   */
+  void
+  pull()
+  {
+    NS_ASSERT(m_size > 0);
+    if (!m_buckets[0].empty())
+      return;
+
+    size_t i = 1;
+    while (m_buckets[i].empty()) {
+      i++;
+    }
+
+    std::vector<value_type>& bucket = m_buckets[i];
+    m_last = std::min_element(bucket.begin(), bucket.end(),
+                              [] (const value_type& a, const value_type& b) {
+                                return a.first < b.first;
+                              })->first;
+    for (const auto& item : bucket) {
+      m_buckets[getBucket(item.first)].push_back(item);
+    }
+    bucket.clear();
+  }
+
+private:
+  std::array<std::vector<value_type>, std::numeric_limits<Key>::digits + 1> m_buckets;
+  Key m_last = 0;
+  size_t m_size = 0;
+};
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Binary heap with the RadixHeap interface, for keys a radix heap cannot handle
+ */
+template<class Key, class Value>
+class BinaryHeap {
+public:
+  typedef std::pair<Key, Value> value_type;
+
+  bool
+  empty() const
+  {
+    return m_queue.empty();
+  }
+
+  size_t
+  size() const
+  {
+    return m_queue.size();
+  }
+
+  void
+  push(Key key, const Value& value)
+  {
+    m_queue.emplace(key, value);
+  }
+
+  const value_type&
+  top()
+  {
+    return m_queue.top();
+  }
+
+  void
+  pop()
+  {
+    m_queue.pop();
+  }
+
+  void
+  clear()
+  {
+    m_queue = decltype(m_queue)();
+  }
+
+private:
+  std::priority_queue<value_type, std::vector<value_type>, std::greater<value_type>> m_queue;
+};
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Priority queue for Dijkstra's algorithm with @p Key distances
+ *
+ * RadixHeap for unsigned integer distances (face metrics), BinaryHeap otherwise.
+ */
+template<class Key, class Value>
+using ShortestPathQueue = typename std::conditional<std::is_unsigned<Key>::value,
+                                                    RadixHeap<Key, Value>,
+                                                    BinaryHeap<Key, Value>>::type;
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RADIX_HEAP_H
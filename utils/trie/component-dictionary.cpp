@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "component-dictionary.hpp"
+
+#include "ns3/assert.h"
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+const uint32_t component_dictionary::INVALID_ID;
+
+// Smallest size of the table (a power of 2)
+static const size_t MIN_TABLE_SIZE = 64;
+
+component_dictionary::component_dictionary()
+  : table_(MIN_TABLE_SIZE, INVALID_ID)
+  , size_(0)
+{
+}
+
+component_dictionary&
+component_dictionary::global()
+{
+  // never destroyed, as tries with static storage duration may release their keys after it
+  static component_dictionary* dictionary = new component_dictionary;
+  return *dictionary;
+}
+
+uint32_t
+component_dictionary::find(const name::Component& component, std::size_t hash) const
+{
+  size_t mask = table_.size() - 1;
+  for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+    uint32_t id = table_[slot];
+    if (id == INVALID_ID)
+      return INVALID_ID;
+
+    const entry& item = entries_[id];
+    if (item.hash == hash && item.component == component)
+      return id;
+  }
+}
+
+uint32_t
+component_dictionary::acquire(const name::Component& component, std::size_t hash)
+{
+  uint32_t id = find(component, hash);
+  if (id != INVALID_ID) {
+    entries_[id].refs++;
+    return id;
+  }
+
+  // a copy of just the component, not of the buffer it points into
+  const Block& wire = component.wireEncode();
+  name::Component copy(Block(wire.wire(), wire.size()));
+
+  if (free_.empty()) {
+    NS_ASSERT_MSG(entries_.size() < INVALID_ID, "Too many name components");
+    id = static_cast<uint32_t>(entries_.size());
+    entries_.push_back(entry{copy, hash, 1});
+  }
+  else {
+    id = free_.back();
+    free_.pop_back();
+    entries_[id] = entry{copy, hash, 1};
+  }
+
+  size_++;
+  if (2 * size_ > table_.size())
+    rehash(2 * table_.size());
+  table_insert(id);
+  return id;
+}
+
+void
+component_dictionary::release(uint32_t id)
+{
+  entry& item = entries_[id];
+  NS_ASSERT(item.refs > 0);
+  if (--item.refs > 0)
+    return;
+
+  // backward shift deletion, so that lookups do not need tombstones
+  size_t mask = table_.size() - 1;
+  size_t hole = item.hash & mask;
+  while (table_[hole] != id)
+    hole = (hole + 1) & mask;
+  table_[hole] = INVALID_ID;
+  for (size_t slot = (hole + 1) & mask; table_[slot] != INVALID_ID; slot = (slot + 1) & mask) {
+    size_t home = entries_[table_[slot]].hash & mask;
+    if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+      table_[hole] = table_[slot];
+      table_[slot] = INVALID_ID;
+      hole = slot;
+    }
+  }
+
+  item.component = name::Component();
+  free_.push_back(id);
+  size_--;
+}
+
+size_t
+component_dictionary::allocated_bytes() const
+{
+  size_t bytes = entries_.size() * sizeof(entry) + free_.capacity() * sizeof(uint32_t)
+                 + table_.capacity() * sizeof(uint32_t);
+  for (const entry& item : entries_) {
+    if (item.refs > 0)
+      bytes += item.component.size() + sizeof(::ndn::Buffer);
+  }
+  return bytes;
+}
+
+void
+component_dictionary::table_insert(uint32_t id)
+{
+  size_t mask = table_.size() - 1;
+  size_t slot = entries_[id].hash & mask;
+  while (table_[slot] != INVALID_ID)
+    slot = (slot + 1) & mask;
+  table_[slot] = id;
+}
+
+void
+component_dictionary::rehash(size_t tableSize)
+{
+  std::vector<uint32_t> old(tableSize, INVALID_ID);
+  table_.swap(old);
+  for (uint32_t id : old) {
+    if (id != INVALID_ID)
+      table_insert(id);
+  }
+}
+
+} // ndnSIM
+} // ndn
+} // ns3
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2019  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef COMPONENT_DICTIONARY_H_
+#define COMPONENT_DICTIONARY_H_
+
+/// @cond include_hidden
+
+#include "trie.hpp"
+
+#include <deque>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Dictionary that maps name components to 32-bit IDs
+ *
+ * IDs are reference counted: acquire() adds a reference (and the component, if it is new),
+ * release() removes one.  The ID of a component without references is reused for other
+ * components.  The dictionary keeps its own copy of the component, so that it does not hold
+ * on to the packet the component came from.
+ */
+class component_dictionary : boost::noncopyable {
+public:
+  static const uint32_t INVALID_ID = std::numeric_limits<uint32_t>::max();
+
+  component_dictionary();
+
+  /**
+   * @brief The dictionary shared by all tries with interned_key_traits
+   */
+  static component_dictionary&
+  global();
+
+  /**
+   * @brief Get the ID of @p component, or INVALID_ID if it has no references
+   * @param hash trie_key_hash of @p component
+   */
+  uint32_t
+  find(const name::Component& component, std::size_t hash) const;
+
+  /**
+   * @brief Add a reference to @p component and get its ID
+   * @param hash trie_key_hash of @p component
+   */
+  uint32_t
+  acquire(const name::Component& component, std::size_t hash);
+
+  /**
+   * @brief Remove a reference from the component with @p id
+   */
+  void
+  release(uint32_t id);
+
+  const name::Component&
+  get(uint32_t id) const
+  {
+    return entries_[id].component;
+  }
+
+  /**
+   * @brief Number of components with references
+   */
+  size_t
+  size() const
+  {
+    return size_;
+  }
+
+  /**
+   * @brief Approximate memory used by the dictionary, including the copies of the components
+   */
+  size_t
+  allocated_bytes() const;
+
+private:
+  void
+  table_insert(uint32_t id);
+
+  void
+  rehash(size_t tableSize);
+
+private:
+  struct entry {
+    name::Component component;
+    std::size_t hash;
+    uint32_t refs;
+  };
+
+  std::deque<entry> entries_; ///< indexed by ID, stable references
+  std::vector<uint32_t> free_; ///< IDs of entries without references
+  std::vector<uint32_t> table_; ///< open addressing with linear probing, INVALID_ID if empty
+  size_t size_;
+};
+
+/**
+ * @brief Keys of trie nodes that store the 32-bit ID of their name component in the global
+ *        component_dictionary
+ *
+ * Nodes of all tries with these traits share one copy of each component, and children are
+ * compared by ID.  Components that are not in the dictionary are not in any of these tries,
+ * so lookups of unknown names stop at the first unknown component.
+ */
+struct interned_key_traits {
+  static std::string
+  GetName()
+  {
+    return "Interned::";
+  }
+
+  static std::string
+  GetLogName()
+  {
+    return "Interned.";
+  }
+
+  typedef uint32_t stored_type;
+
+  struct lookup_type {
+    uint32_t id;
+    std::size_t hash; ///< trie_key_hash of the component
+  };
+
+  static bool
+  prepare(const name::Component& key, lookup_type& lookup)
+  {
+    lookup.hash = trie_key_hash<name::Component>()(key);
+    lookup.id = component_dictionary::global().find(key, lookup.hash);
+    return lookup.id != component_dictionary::INVALID_ID;
+  }
+
+  static stored_type
+  store(const name::Component& key, const lookup_type& lookup)
+  {
+    return component_dictionary::global().acquire(key, lookup.hash);
+  }
+
+  static void
+  release(stored_type& stored)
+  {
+    component_dictionary::global().release(stored);
+  }
+
+  static std::size_t
+  hash(stored_type stored)
+  {
+    return static_cast<std::size_t>((stored * 0x9e3779b97f4a7c15ull) >> 32);
+  }
+
+  static std::size_t
+  hash(const lookup_type& lookup)
+  {
+    return hash(lookup.id);
+  }
+
+  static bool
+  equal(stored_type stored, const lookup_type& lookup)
+  {
+    return stored == lookup.id;
+  }
+
+  static const name::Component&
+  key(stored_type stored)
+  {
+    return component_dictionary::global().get(stored);
+  }
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // COMPONENT_DICTIONARY_H_
@@ -62,6 +62,8 @@ struct fifo_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100)
+        , max_bytes_(0)
+        , bytes_(0)
       {
       }
 
@@ -74,11 +76,19 @@ struct fifo_policy_traits {
       inline bool
       insert(typename parent_trie::iterator item)
       {
+        size_t bytes = item->payload_bytes();
+        if (max_bytes_ != 0 && bytes > max_bytes_)
+          return false; // would not fit even into an empty container
+
         if (max_size_ != 0 && policy_container::size() >= max_size_) {
           base_.erase(&(*policy_container::begin()));
         }
+        while (max_bytes_ != 0 && bytes_ + bytes > max_bytes_) {
+          base_.erase(&(*policy_container::begin()));
+        }
 
         policy_container::push_back(*item);
+        bytes_ += bytes;
         return true;
       }
 
@@ -91,6 +101,7 @@ struct fifo_policy_traits {
       inline void
       erase(typename parent_trie::iterator item)
       {
+        bytes_ -= item->payload_bytes();
         policy_container::erase(policy_container::s_iterator_to(*item));
       }
 
@@ -98,6 +109,7 @@ struct fifo_policy_traits {
       clear()
       {
         policy_container::clear();
+        bytes_ = 0;
       }
 
       inline void
@@ -112,6 +124,24 @@ struct fifo_policy_traits {
         return max_size_;
       }
 
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
+      inline size_t
+      get_size_bytes() const
+      {
+        return bytes_;
+      }
+
     private:
       type()
         : base_(*((Base*)0)){};
@@ -119,6 +149,8 @@ struct fifo_policy_traits {
     private:
       Base& base_;
       size_t max_size_;
+      size_t max_bytes_;
+      size_t bytes_;
     };
   };
 };
@@ -88,6 +88,8 @@ struct lfu_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100)
+        , max_bytes_(0)
+        , bytes_(0)
       {
       }
 
@@ -104,12 +106,20 @@ struct lfu_policy_traits {
       {
         get_order(item) = 0;
 
+        size_t bytes = item->payload_bytes();
+        if (max_bytes_ != 0 && bytes > max_bytes_)
+          return false; // would not fit even into an empty container
+
         if (max_size_ != 0 && policy_container::size() >= max_size_) {
           // this erases the "least frequently used item" from cache
           base_.erase(&(*policy_container::begin()));
         }
+        while (max_bytes_ != 0 && bytes_ + bytes > max_bytes_) {
+          base_.erase(&(*policy_container::begin()));
+        }
 
         policy_container::insert(*item);
+        bytes_ += bytes;
         return true;
       }
 
@@ -124,6 +134,7 @@ struct lfu_policy_traits {
       inline void
       erase(typename parent_trie::iterator item)
       {
+        bytes_ -= item->payload_bytes();
         policy_container::erase(policy_container::s_iterator_to(*item));
       }
 
@@ -131,6 +142,7 @@ struct lfu_policy_traits {
       clear()
       {
         policy_container::clear();
+        bytes_ = 0;
       }
 
       inline void
@@ -145,6 +157,24 @@ struct lfu_policy_traits {
         return max_size_;
       }
 
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
+      inline size_t
+      get_size_bytes() const
+      {
+        return bytes_;
+      }
+
     private:
       type()
         : base_(*((Base*)0)){};
@@ -152,6 +182,8 @@ struct lfu_policy_traits {
     private:
       Base& base_;
       size_t max_size_;
+      size_t max_bytes_;
+      size_t bytes_;
     };
   };
 };
@@ -32,7 +32,8 @@ namespace ndnSIM {
 /**
  * @brief Traits for persistent replacement policy
  *
- * In this policy entries are added until there is a space (controlled by set_max_size call).
+ * In this policy entries are added until there is a space (controlled by set_max_size and
+ * set_max_bytes calls).
  * If maximum is reached, new entries will not be added and nothing will be removed from the
  *container
  */
@@ -65,6 +66,8 @@ struct persistent_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100) // when 0, policy is not enforced
+        , max_bytes_(0)
+        , bytes_(0)
       {
       }
 
@@ -77,10 +80,14 @@ struct persistent_policy_traits {
       inline bool
       insert(typename parent_trie::iterator item)
       {
+        size_t bytes = item->payload_bytes();
         if (max_size_ != 0 && policy_container::size() >= max_size_)
           return false;
+        if (max_bytes_ != 0 && bytes_ + bytes > max_bytes_)
+          return false;
 
         policy_container::push_back(*item);
+        bytes_ += bytes;
         return true;
       }
 
@@ -93,6 +100,7 @@ struct persistent_policy_traits {
       inline void
       erase(typename parent_trie::iterator item)
       {
+        bytes_ -= item->payload_bytes();
         policy_container::erase(policy_container::s_iterator_to(*item));
       }
 
@@ -100,6 +108,7 @@ struct persistent_policy_traits {
       clear()
       {
         policy_container::clear();
+        bytes_ = 0;
       }
 
       inline void
@@ -114,12 +123,32 @@ struct persistent_policy_traits {
         return max_size_;
       }
 
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
+      inline size_t
+      get_size_bytes() const
+      {
+        return bytes_;
+      }
+
     private:
       // type () : base_(*((Base*)0)) { };
 
     private:
       Base& base_;
       size_t max_size_;
+      size_t max_bytes_;
+      size_t bytes_;
     };
   };
 };
@@ -92,6 +92,8 @@ struct random_policy_traits {
         : base_(base)
         , u_rand(CreateObject<UniformRandomVariable>())
         , max_size_(100)
+        , max_bytes_(0)
+        , bytes_(0)
       {
         u_rand->SetAttribute("Min", DoubleValue(0));
         u_rand->SetAttribute("Max", DoubleValue(std::numeric_limits<uint32_t>::max()));
@@ -108,19 +110,33 @@ struct random_policy_traits {
       {
         get_order(item) = u_rand->GetValue();
 
-        if (max_size_ != 0 && policy_container::size() >= max_size_) {
-          if (MemberHookLess<Container>()(*item, *policy_container::begin())) {
-            // std::cout << "Cannot add. Signaling fail\n";
+        size_t bytes = item->payload_bytes();
+        if (max_bytes_ != 0 && bytes > max_bytes_)
+          return false; // would not fit even into an empty container
+
+        // Entries with the lowest order make room for the new one, which has the same chance
+        // to be one that does not stay.  Decide before evicting anything, so that a rejected
+        // item leaves the container as it is.
+        size_t nEvicted = 0;
+        size_t evictedBytes = 0;
+        for (auto victim = policy_container::begin();
+             victim != policy_container::end()
+               && ((max_size_ != 0 && policy_container::size() - nEvicted >= max_size_)
+                   || (max_bytes_ != 0 && bytes_ - evictedBytes + bytes > max_bytes_));
+             victim++) {
+          if (MemberHookLess<Container>()(*item, *victim)) {
             // just return false. Indicating that insert "failed"
             return false;
           }
-          else {
-            // removing some random element
-            base_.erase(&(*policy_container::begin()));
-          }
+          evictedBytes += victim->payload_bytes();
+          nEvicted++;
+        }
+        for (; nEvicted > 0; nEvicted--) {
+          base_.erase(&(*policy_container::begin()));
         }
 
         policy_container::insert(*item);
+        bytes_ += bytes;
         return true;
       }
 
@@ -133,6 +149,7 @@ struct random_policy_traits {
       inline void
       erase(typename parent_trie::iterator item)
       {
+        bytes_ -= item->payload_bytes();
         policy_container::erase(policy_container::s_iterator_to(*item));
       }
 
@@ -140,6 +157,7 @@ struct random_policy_traits {
       clear()
       {
         policy_container::clear();
+        bytes_ = 0;
       }
 
       inline void
@@ -154,6 +172,24 @@ struct random_policy_traits {
         return max_size_;
       }
 
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+
+      inline size_t
+      get_size_bytes() const
+      {
+        return bytes_;
+      }
+
     private:
       type()
         : base_(*((Base*)0)){};
@@ -162,6 +198,8 @@ struct random_policy_traits {
       Base& base_;
       Ptr<UniformRandomVariable> u_rand;
       size_t max_size_;
+      size_t max_bytes_;
+      size_t bytes_;
     };
   };
 };
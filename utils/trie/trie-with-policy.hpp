@@ -28,21 +28,24 @@ namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
-template<typename FullKey, typename PayloadTraits, typename PolicyTraits>
+template<typename FullKey, typename PayloadTraits, typename PolicyTraits,
+         typename KeyTraits = copy_key_traits<typename FullKey::value_type>>
 class trie_with_policy {
 public:
-  typedef trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type> parent_trie;
+  typedef trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type, KeyTraits>
+    parent_trie;
 
   typedef typename parent_trie::iterator iterator;
   typedef typename parent_trie::const_iterator const_iterator;
 
   typedef typename PolicyTraits::
-    template policy<trie_with_policy<FullKey, PayloadTraits, PolicyTraits>, parent_trie,
+    template policy<trie_with_policy<FullKey, PayloadTraits, PolicyTraits, KeyTraits>,
+                    parent_trie,
                     typename PolicyTraits::template container_hook<parent_trie>::type>::type
       policy_container;
 
-  inline trie_with_policy(size_t bucketSize = 1, size_t bucketIncrement = 1)
-    : trie_(name::Component(), bucketSize, bucketIncrement)
+  inline trie_with_policy()
+    : trie_(name::Component())
     , policy_(*this)
   {
   }
@@ -26,14 +26,18 @@
 
 #include "ns3/ptr.h"
 
-#include <boost/intrusive/unordered_set.hpp>
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/functional/hash.hpp>
-#include <boost/interprocess/smart_ptr/unique_ptr.hpp>
+#include <boost/noncopyable.hpp>
 #include <tuple>
 #include <boost/foreach.hpp>
-#include <boost/mpl/if.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -98,24 +102,275 @@ struct non_pointer_traits {
 template<typename Payload, typename BasePayload>
 Payload non_pointer_traits<Payload, BasePayload>::empty_payload = Payload();
 
+/**
+ * @brief Size of payloads in bytes, for policies with a byte limit
+ *
+ * Payloads count as 0 bytes, unless the traits are specialized for their PayloadTraits.
+ */
+template<typename PayloadTraits>
+struct payload_bytes_traits {
+  static size_t
+  bytes(typename PayloadTraits::const_return_type payload)
+  {
+    return 0;
+  }
+};
+
+////////////////////////////////////////////////////
+// Hash of one component of the full key
+//
+template<typename Key>
+struct trie_key_hash {
+  std::size_t
+  operator()(const Key& key) const
+  {
+    return boost::hash<Key>()(key);
+  }
+};
+
+/**
+ * @brief Hash of a name component: TLV type and value, 8 bytes at a time
+ *
+ * Does not need the wire encoding of the component, and is not cryptographic.
+ */
+template<>
+struct trie_key_hash<name::Component> {
+  std::size_t
+  operator()(const name::Component& component) const
+  {
+    const uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+    const uint8_t* value = component.value();
+    size_t size = component.value_size();
+
+    uint64_t hash = (static_cast<uint64_t>(component.type()) << 32 | size) * multiplier;
+    for (; size >= 8; value += 8, size -= 8) {
+      uint64_t word;
+      std::memcpy(&word, value, 8);
+      hash = (hash ^ word) * multiplier;
+      hash ^= hash >> 32;
+    }
+    if (size > 0) {
+      uint64_t tail = 0;
+      std::memcpy(&tail, value, size);
+      hash = (hash ^ tail) * multiplier;
+    }
+    return static_cast<std::size_t>(hash ^ (hash >> 29));
+  }
+};
+
+/**
+ * @brief Keys of trie nodes that store a copy of their key and its hash
+ *
+ * Key traits define how trie nodes store their keys:
+ * - stored_type: the key of a node
+ * - lookup_type: a key prepared for comparisons with stored keys
+ * - prepare(key, lookup): prepare @p key; returns false if no node can have this key
+ * - store(key, lookup): the stored key of a new node, with @p lookup prepared from @p key
+ * - release(stored): called when a node is destroyed
+ * - hash(stored), hash(lookup): same value for equal keys
+ * - equal(stored, lookup)
+ * - key(stored): the key itself
+ * - GetName(): prefix of the NS-3 type names of content stores that use the traits
+ * - GetLogName(): prefix of their log component names (without ':', which NS_LOG uses as a
+ *   separator)
+ */
+template<typename Key>
+struct copy_key_traits {
+  static std::string
+  GetName()
+  {
+    return "";
+  }
+
+  static std::string
+  GetLogName()
+  {
+    return "";
+  }
+
+  struct stored_type {
+    Key key;
+    std::size_t hash;
+  };
+
+  struct lookup_type {
+    const Key* key;
+    std::size_t hash;
+  };
+
+  static bool
+  prepare(const Key& key, lookup_type& lookup)
+  {
+    lookup.key = &key;
+    lookup.hash = trie_key_hash<Key>()(key);
+    return true;
+  }
+
+  static stored_type
+  store(const Key& key, const lookup_type& lookup)
+  {
+    return stored_type{key, lookup.hash};
+  }
+
+  static void
+  release(stored_type&)
+  {
+  }
+
+  static std::size_t
+  hash(const stored_type& stored)
+  {
+    return stored.hash;
+  }
+
+  static std::size_t
+  hash(const lookup_type& lookup)
+  {
+    return lookup.hash;
+  }
+
+  static bool
+  equal(const stored_type& stored, const lookup_type& lookup)
+  {
+    return stored.hash == lookup.hash && stored.key == *lookup.key;
+  }
+
+  static const Key&
+  key(const stored_type& stored)
+  {
+    return stored.key;
+  }
+};
+
+////////////////////////////////////////////////////
+// Memory of the trie nodes
+//
+/**
+ * @brief Pool of fixed-size blocks for the nodes of one trie
+ *
+ * Blocks are carved from chunks of growing size; freed blocks are reused.  The chunks are
+ * only returned to the system by release() or when the pool is destroyed.
+ */
+class trie_node_pool : boost::noncopyable {
+public:
+  explicit trie_node_pool(size_t blockSize)
+    : blockSize_(round_up(std::max(blockSize, sizeof(free_block))))
+    , nextChunkSize_(MIN_CHUNK_BLOCKS)
+    , next_(nullptr)
+    , end_(nullptr)
+    , free_(nullptr)
+    , size_(0)
+  {
+  }
+
+  ~trie_node_pool()
+  {
+    release();
+  }
+
+  void*
+  allocate()
+  {
+    size_++;
+    if (free_ != nullptr) {
+      free_block* block = free_;
+      free_ = free_->next;
+      return block;
+    }
+
+    if (next_ == end_) {
+      size_t bytes = nextChunkSize_ * blockSize_;
+      next_ = static_cast<char*>(::operator new(bytes));
+      end_ = next_ + bytes;
+      chunks_.push_back(next_);
+      nextChunkSize_ = nextChunkSize_ < MAX_CHUNK_BLOCKS ? nextChunkSize_ * 2 : MAX_CHUNK_BLOCKS;
+    }
+    void* block = next_;
+    next_ += blockSize_;
+    return block;
+  }
+
+  void
+  deallocate(void* block)
+  {
+    size_--;
+    free_ = new (block) free_block{free_};
+  }
+
+  /**
+   * @brief Free all chunks at once; blocks still in use must not be accessed afterwards
+   */
+  void
+  release()
+  {
+    for (char* chunk : chunks_) {
+      ::operator delete(chunk);
+    }
+    chunks_.clear();
+    nextChunkSize_ = MIN_CHUNK_BLOCKS;
+    next_ = end_ = nullptr;
+    free_ = nullptr;
+    size_ = 0;
+  }
+
+  /**
+   * @brief Number of blocks in use
+   */
+  size_t
+  size() const
+  {
+    return size_;
+  }
+
+  /**
+   * @brief Bytes allocated from the system
+   */
+  size_t
+  allocated_bytes() const
+  {
+    size_t bytes = 0;
+    for (size_t chunk = 0, blocks = MIN_CHUNK_BLOCKS; chunk < chunks_.size(); chunk++) {
+      bytes += blocks * blockSize_;
+      blocks = blocks < MAX_CHUNK_BLOCKS ? blocks * 2 : MAX_CHUNK_BLOCKS;
+    }
+    return bytes;
+  }
+
+private:
+  struct free_block {
+    free_block* next;
+  };
+
+  static size_t
+  round_up(size_t size)
+  {
+    const size_t alignment = alignof(std::max_align_t);
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+private:
+  static constexpr size_t MIN_CHUNK_BLOCKS = 16;
+  static constexpr size_t MAX_CHUNK_BLOCKS = 1024;
+
+  size_t blockSize_;
+  size_t nextChunkSize_;
+  std::vector<char*> chunks_;
+  char* next_; ///< next unused block of the last chunk
+  char* end_;
+  free_block* free_;
+  size_t size_;
+};
+
 ////////////////////////////////////////////////////
 // forward declarations
 //
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         typename KeyTraits = copy_key_traits<typename FullKey::value_type>>
 class trie;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits>
 inline std::ostream&
-operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
-
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
-bool
-operator==(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-           const trie<FullKey, PayloadTraits, PolicyHook>& b);
-
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
-std::size_t
-hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits>& trie_node);
 
 ///////////////////////////////////////////////////
 // actual definition
@@ -126,8 +381,14 @@ class trie_iterator;
 template<class T>
 class trie_point_iterator;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
-class trie {
+/**
+ * Nodes of a trie are allocated from a pool owned by its root node.  Up to
+ * INLINE_CHILDREN children of a node are stored in the node itself; nodes with more
+ * children keep them in an open addressing hash table keyed by the hash of their keys.
+ * KeyTraits define how the nodes store their keys (see copy_key_traits).
+ */
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits>
+class trie : boost::noncopyable {
 public:
   typedef typename FullKey::value_type Key;
 
@@ -141,31 +402,40 @@ public:
   typedef trie_point_iterator<const trie> const_point_iterator;
 
   typedef PayloadTraits payload_traits;
+  typedef KeyTraits key_traits;
 
-  inline trie(const Key& key, size_t bucketSize = 1, size_t bucketIncrement = 1)
-    : key_(key)
-    , initialBucketSize_(bucketSize)
-    , bucketIncrement_(bucketIncrement)
-    , bucketSize_(initialBucketSize_)
-    , buckets_(new bucket_type[bucketSize_]) // cannot use normal pointer, because lifetime of
-                                             // buckets should be larger than lifetime of the
-                                             // container
-    , children_(bucket_traits(buckets_.get(), bucketSize_))
-    , payload_(PayloadTraits::empty_payload)
-    , parent_(nullptr)
+  /**
+   * @brief Create the root node of a trie
+   */
+  explicit trie(const Key& key)
+    : trie(store_key(key), nullptr, new trie_node_pool(sizeof(trie)))
   {
   }
 
   inline ~trie()
   {
     payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
-    children_.clear_and_dispose(trie_delete_disposer());
+    if (parent_ == nullptr) {
+      // other nodes are destroyed by dispose(), after their children
+      dispose_children(false);
+      delete pool_;
+    }
+    KeyTraits::release(key_);
   }
 
+  /**
+   * @brief Remove all children; for the root node, the memory of all nodes is freed at once
+   */
   void
   clear()
   {
-    children_.clear_and_dispose(trie_delete_disposer());
+    if (parent_ == nullptr) {
+      dispose_children(false);
+      pool_->release();
+    }
+    else {
+      dispose_children(true);
+    }
   }
 
   template<class Predicate>
@@ -183,41 +453,27 @@ public:
     }
   }
 
-  // actual entry
-  friend bool operator==<>(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-                           const trie<FullKey, PayloadTraits, PolicyHook>& b);
-
-  friend std::size_t
-  hash_value<>(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
-
   inline std::pair<iterator, bool>
   insert(const FullKey& key, typename PayloadTraits::insert_type payload)
   {
     trie* trieNode = this;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
-        trie* newNode = new trie(subkey, initialBucketSize_, bucketIncrement_);
-        // std::cout << "new " << newNode << "\n";
-        newNode->parent_ = trieNode;
-
-        if (trieNode->children_.size() >= trieNode->bucketSize_) {
-          trieNode->bucketSize_ += trieNode->bucketIncrement_;
-          trieNode->bucketIncrement_ *= 2; // increase bucketIncrement exponentially
-
-          buckets_array newBuckets(new bucket_type[trieNode->bucketSize_]);
-          trieNode->children_.rehash(bucket_traits(newBuckets.get(), trieNode->bucketSize_));
-          trieNode->buckets_.swap(newBuckets);
+      lookup_type lookup;
+      bool isKnown = KeyTraits::prepare(subkey, lookup);
+      trie* child = isKnown ? trieNode->find_child(lookup) : nullptr;
+      if (child == nullptr) {
+        void* block = pool_->allocate();
+        try {
+          child = new (block) trie(KeyTraits::store(subkey, lookup), trieNode, pool_);
         }
-
-        std::pair<typename unordered_set::iterator, bool> ret =
-          trieNode->children_.insert(*newNode);
-
-        trieNode = &(*ret.first);
+        catch (...) {
+          pool_->deallocate(block);
+          throw;
+        }
+        trieNode->add_child(child);
       }
-      else
-        trieNode = &(*item);
+      trieNode = child;
     }
 
     if (trieNode->payload_ == PayloadTraits::empty_payload) {
@@ -244,14 +500,13 @@ public:
   inline iterator
   prune()
   {
-    if (payload_ == PayloadTraits::empty_payload && children_.size() == 0) {
+    if (payload_ == PayloadTraits::empty_payload && childCount_ == 0) {
       if (parent_ == 0)
         return this;
 
       trie* parent = parent_;
-      parent->children_
-        .erase_and_dispose(*this,
-                           trie_delete_disposer()); // delete this; basically, committing a suicide
+      parent->remove_child(this);
+      dispose(this, true); // delete this; basically, committing a suicide
 
       return parent->prune();
     }
@@ -264,14 +519,12 @@ public:
   inline void
   prune_node()
   {
-    if (payload_ == PayloadTraits::empty_payload && children_.size() == 0) {
+    if (payload_ == PayloadTraits::empty_payload && childCount_ == 0) {
       if (parent_ == 0)
         return;
 
-      trie* parent = parent_;
-      parent->children_
-        .erase_and_dispose(*this,
-                           trie_delete_disposer()); // delete this; basically, committing a suicide
+      parent_->remove_child(this);
+      dispose(this, true); // delete this; basically, committing a suicide
     }
   }
 
@@ -295,13 +548,14 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
+      lookup_type lookup;
+      trie* child = KeyTraits::prepare(subkey, lookup) ? trieNode->find_child(lookup) : nullptr;
+      if (child == nullptr) {
         reachLast = false;
         break;
       }
       else {
-        trieNode = &(*item);
+        trieNode = child;
 
         if (trieNode->payload_ != PayloadTraits::empty_payload)
           foundNode = trieNode;
@@ -326,13 +580,14 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
-      if (item == trieNode->children_.end()) {
+      lookup_type lookup;
+      trie* child = KeyTraits::prepare(subkey, lookup) ? trieNode->find_child(lookup) : nullptr;
+      if (child == nullptr) {
         reachLast = false;
         break;
       }
       else {
-        trieNode = &(*item);
+        trieNode = child;
 
         if (trieNode->payload_ != PayloadTraits::empty_payload && pred(trieNode->payload_)) {
           foundNode = trieNode;
@@ -354,11 +609,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload)
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++)
-    // BOOST_FOREACH (trie &subnode, children_)
-    {
+    for (trie* subnode = first_child(); subnode != nullptr; subnode = next_child(subnode)) {
       iterator value = subnode->find();
       if (value != 0)
         return value;
@@ -380,11 +631,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload && pred(payload_))
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++)
-    // BOOST_FOREACH (const trie &subnode, children_)
-    {
+    for (trie* subnode = first_child(); subnode != nullptr; subnode = next_child(subnode)) {
       iterator value = subnode->find_if(pred);
       if (value != 0)
         return value;
@@ -406,9 +653,7 @@ public:
   inline const iterator
   find_if_next_level(Predicate pred)
   {
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
-         subnode != children_.end(); subnode++) {
+    for (trie* subnode = first_child(); subnode != nullptr; subnode = next_child(subnode)) {
       if (pred(subnode->key())) {
         return subnode->find();
       }
@@ -447,33 +692,254 @@ public:
     payload_ = payload;
   }
 
-  Key
+  const Key&
   key() const
   {
-    return key_;
+    return KeyTraits::key(key_);
+  }
+
+  /**
+   * @brief Size of the payload in bytes (see payload_bytes_traits)
+   */
+  size_t
+  payload_bytes() const
+  {
+    return payload_bytes_traits<PayloadTraits>::bytes(payload_);
+  }
+
+  /**
+   * @brief Number of nodes of the whole trie, including the root
+   */
+  size_t
+  node_count() const
+  {
+    return pool_->size() + 1;
+  }
+
+  /**
+   * @brief Bytes used by the nodes of the whole trie and their child tables
+   *
+   * Includes unused pool memory, but not memory referenced by the keys and payloads.
+   */
+  size_t
+  allocated_bytes() const
+  {
+    size_t bytes = pool_->allocated_bytes() + sizeof(trie_node_pool);
+    for (const_recursive_iterator node(*this), end(0); node != end; node++) {
+      bytes += node->tableSize_ * sizeof(trie*);
+    }
+    return bytes;
   }
 
   inline void
   PrintStat(std::ostream& os) const;
 
 private:
-  // The disposer object function
-  struct trie_delete_disposer {
-    void
-    operator()(trie* delete_this)
-    {
-      delete delete_this;
+  /// Maximum number of children stored in the node itself
+  static constexpr uint32_t INLINE_CHILDREN = 4;
+  /// Smallest size of a child table (a power of 2)
+  static constexpr uint32_t MIN_TABLE_SIZE = 16;
+
+  typedef typename KeyTraits::stored_type stored_type;
+  typedef typename KeyTraits::lookup_type lookup_type;
+
+  inline trie(const stored_type& key, trie* parent, trie_node_pool* pool)
+    : key_(key)
+    , payload_(PayloadTraits::empty_payload)
+    , parent_(parent)
+    , pool_(pool)
+    , childCount_(0)
+    , tableSize_(0)
+  {
+  }
+
+  static stored_type
+  store_key(const Key& key)
+  {
+    lookup_type lookup;
+    KeyTraits::prepare(key, lookup);
+    return KeyTraits::store(key, lookup);
+  }
+
+  /**
+   * @brief Destroy @p node, which has no children left; return its memory to the pool if
+   *        @p deallocate is true
+   */
+  static void
+  dispose(trie* node, bool deallocate)
+  {
+    trie_node_pool* pool = node->pool_;
+    node->~trie();
+    if (deallocate)
+      pool->deallocate(node);
+  }
+
+  void
+  dispose_children(bool deallocate)
+  {
+    trie** children = tableSize_ == 0 ? children_.local : children_.table;
+    for (uint32_t i = 0, size = tableSize_ == 0 ? childCount_ : tableSize_; i < size; i++) {
+      if (children[i] != nullptr) {
+        children[i]->dispose_children(deallocate);
+        dispose(children[i], deallocate);
+      }
     }
-  };
+    if (tableSize_ != 0)
+      delete[] children_.table;
+    childCount_ = 0;
+    tableSize_ = 0;
+  }
 
-  template<class D>
-  struct array_disposer {
-    void
-    operator()(D* array)
-    {
-      delete[] array;
+  trie*
+  find_child(const lookup_type& lookup) const
+  {
+    if (tableSize_ == 0) {
+      for (uint32_t i = 0; i < childCount_; i++) {
+        trie* child = children_.local[i];
+        if (KeyTraits::equal(child->key_, lookup))
+          return child;
+      }
+      return nullptr;
     }
-  };
+
+    std::size_t mask = tableSize_ - 1;
+    for (std::size_t slot = KeyTraits::hash(lookup) & mask;; slot = (slot + 1) & mask) {
+      trie* child = children_.table[slot];
+      if (child == nullptr || KeyTraits::equal(child->key_, lookup))
+        return child;
+    }
+  }
+
+  void
+  add_child(trie* child)
+  {
+    if (tableSize_ == 0 && childCount_ < INLINE_CHILDREN) {
+      children_.local[childCount_++] = child;
+      return;
+    }
+
+    if (2 * (childCount_ + 1) > tableSize_)
+      rehash(std::max(MIN_TABLE_SIZE, 2 * tableSize_));
+    table_insert(child);
+    childCount_++;
+  }
+
+  void
+  remove_child(trie* child)
+  {
+    if (tableSize_ == 0) {
+      trie** local = children_.local;
+      std::remove(local, local + childCount_, child);
+      childCount_--;
+      return;
+    }
+
+    // backward shift deletion, so that lookups do not need tombstones
+    trie** table = children_.table;
+    std::size_t mask = tableSize_ - 1;
+    std::size_t hole = table_slot(child);
+    table[hole] = nullptr;
+    for (std::size_t slot = (hole + 1) & mask; table[slot] != nullptr; slot = (slot + 1) & mask) {
+      std::size_t home = KeyTraits::hash(table[slot]->key_) & mask;
+      if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+        table[hole] = table[slot];
+        table[slot] = nullptr;
+        hole = slot;
+      }
+    }
+    childCount_--;
+
+    if (childCount_ <= INLINE_CHILDREN / 2)
+      rehash(0);
+    else if (tableSize_ > MIN_TABLE_SIZE && 8 * childCount_ < tableSize_)
+      rehash(tableSize_ / 2);
+  }
+
+  /**
+   * @brief Move the children to a table of @p tableSize slots, or inline if it is 0
+   */
+  void
+  rehash(uint32_t tableSize)
+  {
+    trie* local[INLINE_CHILDREN];
+    trie** old = tableSize_ == 0 ? local : children_.table;
+    uint32_t oldSize = tableSize_ == 0 ? childCount_ : tableSize_;
+    if (tableSize_ == 0)
+      std::copy(children_.local, children_.local + childCount_, local);
+
+    if (tableSize == 0) {
+      uint32_t count = 0;
+      for (uint32_t i = 0; i < oldSize; i++) {
+        if (old[i] != nullptr)
+          children_.local[count++] = old[i];
+      }
+    }
+    else {
+      children_.table = new trie*[tableSize]();
+    }
+    tableSize_ = tableSize;
+
+    if (tableSize != 0) {
+      for (uint32_t i = 0; i < oldSize; i++) {
+        if (old[i] != nullptr)
+          table_insert(old[i]);
+      }
+    }
+    if (old != local)
+      delete[] old;
+  }
+
+  void
+  table_insert(trie* child)
+  {
+    std::size_t mask = tableSize_ - 1;
+    std::size_t slot = KeyTraits::hash(child->key_) & mask;
+    while (children_.table[slot] != nullptr)
+      slot = (slot + 1) & mask;
+    children_.table[slot] = child;
+  }
+
+  std::size_t
+  table_slot(const trie* child) const
+  {
+    std::size_t mask = tableSize_ - 1;
+    std::size_t slot = KeyTraits::hash(child->key_) & mask;
+    while (children_.table[slot] != child)
+      slot = (slot + 1) & mask;
+    return slot;
+  }
+
+  trie*
+  first_child() const
+  {
+    if (tableSize_ == 0)
+      return childCount_ > 0 ? children_.local[0] : nullptr;
+    return next_slot(0);
+  }
+
+  /**
+   * @brief Child that follows @p child in the (unspecified) order of the children
+   */
+  trie*
+  next_child(const trie* child) const
+  {
+    if (tableSize_ == 0) {
+      trie* const* end = children_.local + childCount_;
+      trie* const* item = std::find(children_.local, end, child);
+      return item + 1 < end ? *(item + 1) : nullptr;
+    }
+    return next_slot(table_slot(child) + 1);
+  }
+
+  trie*
+  next_slot(std::size_t slot) const
+  {
+    for (; slot < tableSize_; slot++) {
+      if (children_.table[slot] != nullptr)
+        return children_.table[slot];
+    }
+    return nullptr;
+  }
 
   friend std::ostream& operator<<<>(std::ostream& os, const trie& trie_node);
 
@@ -481,17 +947,6 @@ public:
   PolicyHook policy_hook_;
 
 private:
-  boost::intrusive::unordered_set_member_hook<> unordered_set_member_hook_;
-
-  // necessary typedefs
-  typedef trie self_type;
-  typedef boost::intrusive::member_hook<trie, boost::intrusive::unordered_set_member_hook<>,
-                                        &trie::unordered_set_member_hook_> member_hook;
-
-  typedef boost::intrusive::unordered_set<trie, member_hook> unordered_set;
-  typedef typename unordered_set::bucket_type bucket_type;
-  typedef typename unordered_set::bucket_traits bucket_traits;
-
   template<class T, class NonConstT>
   friend class trie_iterator;
 
@@ -502,43 +957,47 @@ private:
   // Actual data
   ////////////////////////////////////////////////
 
-  Key key_; ///< name component
-
-  size_t initialBucketSize_;
-  size_t bucketIncrement_;
-
-  size_t bucketSize_;
-  typedef boost::interprocess::unique_ptr<bucket_type, array_disposer<bucket_type>> buckets_array;
-  buckets_array buckets_;
-  unordered_set children_;
+  stored_type key_; ///< name component
 
   typename PayloadTraits::storage_type payload_;
   trie* parent_; // to make cleaning effective
+  trie_node_pool* pool_; ///< owned by the root node
+
+  uint32_t childCount_;
+  uint32_t tableSize_; ///< 0 while the children are stored inline
+  union {
+    trie* local[INLINE_CHILDREN];
+    trie** table; ///< open addressing with linear probing, nullptr for empty slots
+  } children_;
 };
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits>
+constexpr uint32_t trie<FullKey, PayloadTraits, PolicyHook, KeyTraits>::INLINE_CHILDREN;
+
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits>
+constexpr uint32_t trie<FullKey, PayloadTraits, PolicyHook, KeyTraits>::MIN_TABLE_SIZE;
+
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits>
 inline std::ostream&
-operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
+operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook, KeyTraits>& trie_node)
 {
-  os << "# " << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "")
+  os << "# " << trie_node.key() << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "")
      << std::endl;
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+  typedef trie<FullKey, PayloadTraits, PolicyHook, KeyTraits> trie;
 
-  for (typename trie::unordered_set::const_iterator subnode = trie_node.children_.begin();
-       subnode != trie_node.children_.end(); subnode++)
-  // BOOST_FOREACH (const trie &subnode, trie_node.children_)
-  {
+  for (const trie* subnode = trie_node.first_child(); subnode != nullptr;
+       subnode = trie_node.next_child(subnode)) {
     os << "\"" << &trie_node << "\""
-       << " [label=\"" << trie_node.key_
+       << " [label=\"" << trie_node.key()
        << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]\n";
-    os << "\"" << &(*subnode) << "\""
-       << " [label=\"" << subnode->key_
+    os << "\"" << subnode << "\""
+       << " [label=\"" << subnode->key()
        << ((subnode->payload_ != PayloadTraits::empty_payload) ? "*" : "") << "\"]"
                                                                               "\n";
 
     os << "\"" << &trie_node << "\""
        << " -> "
-       << "\"" << &(*subnode) << "\""
+       << "\"" << subnode << "\""
        << "\n";
     os << *subnode;
   }
@@ -546,41 +1005,21 @@ operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& tri
   return os;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename KeyTraits>
 inline void
-trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
+trie<FullKey, PayloadTraits, PolicyHook, KeyTraits>::PrintStat(std::ostream& os) const
 {
-  os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload) ? "*" : "") << ": "
-     << children_.size() << " children" << std::endl;
-  for (size_t bucket = 0, maxbucket = children_.bucket_count(); bucket < maxbucket; bucket++) {
-    os << " " << children_.bucket_size(bucket);
-  }
-  os << "\n";
+  os << "# " << key() << ((payload_ != PayloadTraits::empty_payload) ? "*" : "") << ": "
+     << childCount_ << " children";
+  if (tableSize_ != 0)
+    os << " in " << tableSize_ << " slots";
+  os << std::endl;
 
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-  for (typename trie::unordered_set::const_iterator subnode = children_.begin();
-       subnode != children_.end(); subnode++)
-  // BOOST_FOREACH (const trie &subnode, children_)
-  {
+  for (const trie* subnode = first_child(); subnode != nullptr; subnode = next_child(subnode)) {
     subnode->PrintStat(os);
   }
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
-inline bool
-operator==(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-           const trie<FullKey, PayloadTraits, PolicyHook>& b)
-{
-  return a.key_ == b.key_;
-}
-
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
-inline std::size_t
-hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
-{
-  return boost::hash_value(trie_node.key_);
-}
-
 template<class Trie, class NonConstTrie> // hack for boost < 1.47
 class trie_iterator {
 public:
@@ -637,8 +1076,8 @@ public:
   trie_iterator<Trie, NonConstTrie>&
   operator++(int)
   {
-    if (trie_->children_.size() > 0)
-      trie_ = &(*trie_->children_.begin());
+    if (trie_->childCount_ > 0)
+      trie_ = trie_->first_child();
     else
       trie_ = goUp();
     return *this;
@@ -652,20 +1091,13 @@ public:
   }
 
 private:
-  typedef typename boost::mpl::if_<boost::is_same<Trie, NonConstTrie>,
-                                   typename Trie::unordered_set::iterator,
-                                   typename Trie::unordered_set::const_iterator>::type set_iterator;
-
   Trie*
   goUp()
   {
     if (trie_->parent_ != 0) {
-      // typename Trie::unordered_set::iterator item =
-      set_iterator item = const_cast<NonConstTrie*>(trie_)
-                            ->parent_->children_.iterator_to(const_cast<NonConstTrie&>(*trie_));
-      item++;
-      if (item != trie_->parent_->children_.end()) {
-        return &(*item);
+      Trie* next = trie_->parent_->next_child(trie_);
+      if (next != 0) {
+        return next;
       }
       else {
         trie_ = trie_->parent_;
@@ -682,11 +1114,6 @@ private:
 
 template<class Trie>
 class trie_point_iterator {
-private:
-  typedef typename boost::mpl::if_<boost::is_same<Trie, const Trie>,
-                                   typename Trie::unordered_set::const_iterator,
-                                   typename Trie::unordered_set::iterator>::type set_iterator;
-
 public:
   trie_point_iterator()
     : trie_(0)
@@ -697,11 +1124,8 @@ public:
   {
   }
   trie_point_iterator(Trie& item)
+    : trie_(item.first_child())
   {
-    if (item.children_.size() != 0)
-      trie_ = &*item.children_.begin();
-    else
-      trie_ = 0;
   }
 
   Trie& operator*()
@@ -744,17 +1168,10 @@ public:
   trie_point_iterator<Trie>&
   operator++(int)
   {
-    if (trie_->parent_ != 0) {
-      set_iterator item = trie_->parent_->children_.iterator_to(*trie_);
-      item++;
-      if (item == trie_->parent_->children_.end())
-        trie_ = 0;
-      else
-        trie_ = &*item;
-    }
-    else {
+    if (trie_->parent_ != 0)
+      trie_ = trie_->parent_->next_child(trie_);
+    else
       trie_ = 0;
-    }
     return *this;
   }
 